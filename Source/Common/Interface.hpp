@@ -13,6 +13,7 @@
 
 	#define IStream std::cin
 	#define OStream std::cout
+	#define EStream std::cerr
 
 	#define endLine std::endl
 
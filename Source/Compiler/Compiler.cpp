@@ -21,8 +21,13 @@
 #ifndef SPIN_COMPILER_CPP
 #define SPIN_COMPILER_CPP
 
+#include <algorithm>
+
 #include "../Types/Complex.hpp"
-#include "../Virtual/Processor.hpp"
+#include "Evaluator.hpp"
+#include "Graph.hpp"
+#include "Optimiser.hpp"
+#include "Verifier.hpp"
 
 #define rethrow(A) try { A; } catch (Program::Error & e) { throw; }
 
@@ -680,6 +685,69 @@ namespace Spin {
 		{ compose(Type::ComplexType, Type::RealType), true },
 		{ compose(Type::ComplexType, Type::ImaginaryType), true },
 	};
+	const Dictionary<Binary, OPCode> Compiler::specialisedTable = {
+		// Integer Arithmetic:
+		{ compose(OPCode::ADD, Type::NaturalType, Type::NaturalType), OPCode::ADI },
+		{ compose(OPCode::ADD, Type::NaturalType, Type::IntegerType), OPCode::ADI },
+		{ compose(OPCode::ADD, Type::IntegerType, Type::NaturalType), OPCode::ADI },
+		{ compose(OPCode::ADD, Type::IntegerType, Type::IntegerType), OPCode::ADI },
+		{ compose(OPCode::SUB, Type::NaturalType, Type::NaturalType), OPCode::SBI },
+		{ compose(OPCode::SUB, Type::NaturalType, Type::IntegerType), OPCode::SBI },
+		{ compose(OPCode::SUB, Type::IntegerType, Type::NaturalType), OPCode::SBI },
+		{ compose(OPCode::SUB, Type::IntegerType, Type::IntegerType), OPCode::SBI },
+		{ compose(OPCode::MUL, Type::NaturalType, Type::NaturalType), OPCode::MLI },
+		{ compose(OPCode::MUL, Type::NaturalType, Type::IntegerType), OPCode::MLI },
+		{ compose(OPCode::MUL, Type::IntegerType, Type::IntegerType), OPCode::MLI },
+		{ compose(OPCode::DIV, Type::IntegerType, Type::IntegerType), OPCode::DVI },
+		{ compose(OPCode::MOD, Type::IntegerType, Type::IntegerType), OPCode::MDI },
+		// Real Arithmetic:
+		{ compose(OPCode::ADD, Type::RealType, Type::RealType), OPCode::ADR },
+		{ compose(OPCode::ADD, Type::ImaginaryType, Type::ImaginaryType), OPCode::ADR },
+		{ compose(OPCode::SUB, Type::RealType, Type::RealType), OPCode::SBR },
+		{ compose(OPCode::SUB, Type::ImaginaryType, Type::ImaginaryType), OPCode::SBR },
+		{ compose(OPCode::MUL, Type::RealType, Type::RealType), OPCode::MLR },
+		{ compose(OPCode::MUL, Type::RealType, Type::ImaginaryType), OPCode::MLR },
+		{ compose(OPCode::MUL, Type::ImaginaryType, Type::RealType), OPCode::MLR },
+		{ compose(OPCode::MUL, Type::ImaginaryType, Type::ImaginaryType), OPCode::MLR },
+		{ compose(OPCode::DIV, Type::RealType, Type::RealType), OPCode::DVR },
+		{ compose(OPCode::DIV, Type::RealType, Type::ImaginaryType), OPCode::DVR },
+		{ compose(OPCode::DIV, Type::ImaginaryType, Type::RealType), OPCode::DVR },
+		{ compose(OPCode::DIV, Type::ImaginaryType, Type::ImaginaryType), OPCode::DVR },
+		// Integer Comparison:
+		{ compose(OPCode::EQL, Type::NaturalType, Type::NaturalType), OPCode::EQI },
+		{ compose(OPCode::EQL, Type::NaturalType, Type::IntegerType), OPCode::EQI },
+		{ compose(OPCode::EQL, Type::IntegerType, Type::NaturalType), OPCode::EQI },
+		{ compose(OPCode::EQL, Type::IntegerType, Type::IntegerType), OPCode::EQI },
+		{ compose(OPCode::NEQ, Type::NaturalType, Type::NaturalType), OPCode::NEI },
+		{ compose(OPCode::NEQ, Type::NaturalType, Type::IntegerType), OPCode::NEI },
+		{ compose(OPCode::NEQ, Type::IntegerType, Type::NaturalType), OPCode::NEI },
+		{ compose(OPCode::NEQ, Type::IntegerType, Type::IntegerType), OPCode::NEI },
+		{ compose(OPCode::GRT, Type::NaturalType, Type::IntegerType), OPCode::GRI },
+		{ compose(OPCode::GRT, Type::IntegerType, Type::NaturalType), OPCode::GRI },
+		{ compose(OPCode::GRT, Type::IntegerType, Type::IntegerType), OPCode::GRI },
+		{ compose(OPCode::LSS, Type::NaturalType, Type::IntegerType), OPCode::LSI },
+		{ compose(OPCode::LSS, Type::IntegerType, Type::NaturalType), OPCode::LSI },
+		{ compose(OPCode::LSS, Type::IntegerType, Type::IntegerType), OPCode::LSI },
+		{ compose(OPCode::GEQ, Type::NaturalType, Type::IntegerType), OPCode::GEI },
+		{ compose(OPCode::GEQ, Type::IntegerType, Type::NaturalType), OPCode::GEI },
+		{ compose(OPCode::GEQ, Type::IntegerType, Type::IntegerType), OPCode::GEI },
+		{ compose(OPCode::LEQ, Type::NaturalType, Type::IntegerType), OPCode::LEI },
+		{ compose(OPCode::LEQ, Type::IntegerType, Type::NaturalType), OPCode::LEI },
+		{ compose(OPCode::LEQ, Type::IntegerType, Type::IntegerType), OPCode::LEI },
+		// Real Comparison:
+		{ compose(OPCode::EQL, Type::RealType, Type::RealType), OPCode::EQR },
+		{ compose(OPCode::EQL, Type::ImaginaryType, Type::ImaginaryType), OPCode::EQR },
+		{ compose(OPCode::NEQ, Type::RealType, Type::RealType), OPCode::NER },
+		{ compose(OPCode::NEQ, Type::ImaginaryType, Type::ImaginaryType), OPCode::NER },
+		{ compose(OPCode::GRT, Type::RealType, Type::RealType), OPCode::GRR },
+		{ compose(OPCode::GRT, Type::ImaginaryType, Type::ImaginaryType), OPCode::GRR },
+		{ compose(OPCode::LSS, Type::RealType, Type::RealType), OPCode::LSR },
+		{ compose(OPCode::LSS, Type::ImaginaryType, Type::ImaginaryType), OPCode::LSR },
+		{ compose(OPCode::GEQ, Type::RealType, Type::RealType), OPCode::GER },
+		{ compose(OPCode::GEQ, Type::ImaginaryType, Type::ImaginaryType), OPCode::GER },
+		{ compose(OPCode::LEQ, Type::RealType, Type::RealType), OPCode::LER },
+		{ compose(OPCode::LEQ, Type::ImaginaryType, Type::ImaginaryType), OPCode::LER },
+	};
 
 	Compiler::TypeNode * Compiler::type() {
 		if (match(Token::Type::basicType))
@@ -1649,6 +1717,7 @@ namespace Spin {
 					OPCode::CST,
 					{ .types = runtimeCompose(typeB, typeA) }
 				});
+				fold(token);
 			}
 		}
 		pushType(typeA);
@@ -1769,6 +1838,7 @@ namespace Spin {
 		Routine routine; routine.type = lamdaNode;
 		routine.parameters = types; routine.scope = scope;
 		routine.returnType = returnType; routine.frame = frame;
+		routine.line = sourceLine();
 		const SizeType routineIndex = routines.size();
 		// Notifying the return statements:
 		routineIndexes.push(routineIndex);
@@ -1874,7 +1944,7 @@ namespace Spin {
 			default: break;
 		}
 		pushType(search -> second);
-		foldUnary(token);
+		fold(token);
 	}
 	void Compiler::binary() {
 		const Token token = previous;
@@ -1917,7 +1987,7 @@ namespace Spin {
 			default: break;
 		}
 		pushType(search -> second);
-		foldBinary(token);
+		fold(token);
 	}
 	void Compiler::prefix() {
 		const Token token = previous;
@@ -1941,7 +2011,7 @@ namespace Spin {
 			default: break;
 		}
 		pushType(search -> second);
-		foldUnary(token);
+		fold(token);
 	}
 	void Compiler::read() {
 		const Token token = previous;
@@ -2590,6 +2660,7 @@ namespace Spin {
 		Routine routine; routine.name = id;
 		routine.parameters = types; routine.scope = scope;
 		routine.frame = frame;
+		routine.line = sourceLine();
 		routine.returnType = new TypeNode(Type::VoidType);
 		const SizeType routineIndex = routines.size();
 		// Notifying the return statements:
@@ -2686,6 +2757,7 @@ namespace Spin {
 		Routine routine; routine.name = id;
 		routine.parameters = types; routine.scope = scope;
 		routine.returnType = returnType; routine.frame = frame;
+		routine.line = sourceLine();
 		const SizeType routineIndex = routines.size();
 		// Notifying the return statements:
 		routineIndexes.push(routineIndex);
@@ -2797,6 +2869,14 @@ namespace Spin {
 				}
 			}
 			routine.returns = true;
+			// A call in tail position (SSF, CAL) becomes a
+			// tail call, which moves its arguments over the
+			// current frame and jumps, so that the routine
+			// returns straight to its caller. The epilogue
+			// stays for the other paths reaching it (eg: the
+			// first branch of a ternary operator):
+			ByteCode & last = program -> instructions.back();
+			if (last.code == OPCode::CAL) last.code = OPCode::TCL;
 			// Back up of the top of the stack before POP:
 			emitOperation(OPCode::CTP);
 			emitPop(countLocals(routine.scope));
@@ -2957,62 +3037,23 @@ namespace Spin {
 		assignmentStack.decrease();
 	}
 
-	void Compiler::foldUnary(Token token) {
+	void Compiler::fold(Token token) {
 		if (!options.folding) return;
-		const SizeType size = program -> instructions.size();
-		ByteCode op = program -> instructions.at(size - 2);
-		switch (op.code) {
-			case OPCode::PSH:
-			case OPCode::PST:
-			case OPCode::PSF: break;
-			default: return;
-		}
-		Array<ByteCode> codes;
-		codes.push_back(op);
-		op = program -> instructions.at(size - 1);
-		if (op.as.type > Type::ImaginaryType) return;
-		codes.push_back(op);
-		program -> instructions.pop_back();
-		program -> instructions.pop_back();
-		Value v;
-		try { v = Processor::self() -> fold(codes); }
-		catch (Processor::Crash & c) {
-			throw Program::Error(
-				currentUnit,
-				"Detected invalid operation '" + token.lexeme +
-				"' that will cause a runtime crash!",
-				token, ErrorCode::evl
-			);
+		Array<ByteCode> & code = program -> instructions;
+		const ByteCode operation = code.back();
+		const SizeType arity = Evaluator::arity(operation);
+		if (!arity || code.size() <= arity) return;
+		// The operands can't be the target of a jump:
+		const SizeType first = code.size() - 1 - arity;
+		if (first < barrier) return;
+		Value operands[2];
+		for (SizeType i = 0; i < arity; i += 1) {
+			if (!Evaluator::constant(code[first + i], operands[i])) return;
 		}
-		emitOperation({ OPCode::PSH, { .value = v } });
-	}
-	void Compiler::foldBinary(Token token) {
-		if (!options.folding) return;
-		const SizeType size = program -> instructions.size();
-		Array<ByteCode> codes;
-		ByteCode op;
-		for (SizeType i = 3; i > 1; i -= 1) {
-			op = program -> instructions.at(size - i);
-			switch (op.code) {
-				case OPCode::PSH:
-				case OPCode::PST:
-				case OPCode::PSF: break;
-				default: return;
-			}
-			codes.push_back(op);
-		}
-		op = program -> instructions.at(size - 1);
-		const Type typeA = (Type)(op.as.types >> 8);
-		const Type typeB = (Type)(op.as.types & 0xFF);
-		if (typeA > Type::ImaginaryType ||
-			typeB > Type::ImaginaryType) return;
-		codes.push_back(op);
-		program -> instructions.pop_back();
-		program -> instructions.pop_back();
-		program -> instructions.pop_back();
 		Value v;
-		try { v = Processor::self() -> fold(codes); }
-		catch (Processor::Crash & c) {
+		try {
+			if (!Evaluator::evaluate(operation, operands, v)) return;
+		} catch (Evaluator::Invalid & e) {
 			throw Program::Error(
 				currentUnit,
 				"Detected invalid operation '" + token.lexeme +
@@ -3020,6 +3061,7 @@ namespace Spin {
 				token, ErrorCode::evl
 			);
 		}
+		code.resize(first);
 		emitOperation({ OPCode::PSH, { .value = v } });
 	}
 
@@ -3161,16 +3203,23 @@ namespace Spin {
 	}
 	inline void Compiler::resolveRoutines() {
 		const SizeType size = routines.size();
+		// The table of the routines starts with the main:
+		program -> routines.push_back({ "main", 0, 0 });
 		for (SizeType i = 0; i < size; i += 1) {
 			Routine routine = routines[i];
 			if (routine.name.empty()) {
 				if (options.sectors) emitRest();
+				arities[sourcePosition()] = routine.parameters.size();
+				program -> routines.push_back({
+					"lamda", sourcePosition(), routine.line
+				});
 				// Using a temp lamda op to get the real position:
+				// (it stays a TLT until all the passes that
+				// can move instructions are done):
 				for (ByteCode & byte : program -> instructions) {
 					if (byte.code != OPCode::TLT) continue;
 					if (byte.as.index != i) continue;
 					byte.as.index = sourcePosition();
-					byte.code = OPCode::PSH;
 				}
 				pasteCodes(routine.code);
 				continue;
@@ -3182,12 +3231,16 @@ namespace Spin {
 			if (j == - 1) continue;
 			if (options.sectors) emitRest();
 			prototypes.at(j).address = sourcePosition();
+			arities[sourcePosition()] = routine.parameters.size();
+			program -> routines.push_back({
+				routine.name, sourcePosition(), routine.line
+			});
 			pasteCodes(routine.code);
 		}
 	}
 	inline void Compiler::resolveCalls() {
 		for (ByteCode & byte : program -> instructions) {
-			if (byte.code != OPCode::CAL) continue;
+			if (byte.code != OPCode::CAL && byte.code != OPCode::TCL) continue;
 			byte.as.index = prototypes.at(byte.as.index).address;
 		}
 	}
@@ -3210,6 +3263,303 @@ namespace Spin {
 			}
 		}
 	}
+	inline void Compiler::inlineRoutines() {
+		// Calls (SSF, CAL) to small routines are replaced
+		// with the reachable code of the routine. Its frame
+		// starts where the arguments are, so the depth of
+		// the stack at the call (see Graph.hpp) moves its
+		// parameters and locals to slots of the caller, and
+		// its returns become jumps to the return site.
+		// Copies are taken from the code before inlining:
+		// recursive routines are unrolled once and the
+		// routines themselves stay (lamdas and the calls
+		// that couldn't be inlined still reach them):
+		Graph graph(program);
+		graph.measure();
+		const Array<ByteCode> & codes = program -> instructions;
+		const SizeType size = codes.size();
+		// Reachable code of a routine, empty when it can't
+		// be copied:
+		Dictionary<SizeType, Array<SizeType>> bodies;
+		auto body = [&] (SizeType entry) -> const Array<SizeType> & {
+			auto found = bodies.find(entry);
+			if (found != bodies.end()) return found -> second;
+			Array<SizeType> & addresses = bodies[entry];
+			const SizeType r = graph.blocks[graph.owners[entry]].region;
+			if (r == Graph::none) return addresses;
+			const Graph::Region & region = graph.regions[r];
+			if (region.result == Graph::unknown) return addresses;
+			if (graph.blocks[region.entry].begin != entry) return addresses;
+			Array<SizeType> copied;
+			for (SizeType b : region.order) {
+				const Graph::Block & block = graph.blocks[b];
+				for (SizeType i = block.begin; i < block.end; i += 1) {
+					switch (codes[i].code) {
+						// Slots computed at runtime:
+						case OPCode::SWP: return addresses;
+						// Tail calls replace a frame of its own:
+						case OPCode::TCL: return addresses;
+						case OPCode::RET:
+							if (graph.depth(i) != region.result) return addresses;
+						break;
+						default: break;
+					}
+					copied.push_back(i);
+				}
+			}
+			// The last return isn't copied:
+			if (copied.size() > options.inlining + 1) return addresses;
+			std::sort(copied.begin(), copied.end());
+			addresses = copied;
+			return addresses;
+		};
+		struct Site {
+			SizeType call = 0;
+			SizeType entry = 0;
+			// Slot of the first parameter:
+			Int64 slot = 0;
+			Boolean frame = false;
+		};
+		Array<Site> sites;
+		for (SizeType i = 1; i < size; i += 1) {
+			if (codes[i].code != OPCode::CAL) continue;
+			if (codes[i - 1].code != OPCode::SSF) continue;
+			if (codes[i].as.index >= size) continue;
+			const SizeType r = graph.blocks[graph.owners[i]].region;
+			if (r == Graph::none) continue;
+			const Int64 depth = graph.depth(i - 1);
+			if (depth == Graph::unknown) continue;
+			if (body(codes[i].as.index).empty()) continue;
+			Site site;
+			site.call = i;
+			site.entry = codes[i].as.index;
+			site.slot = depth - (Int64) codes[i - 1].as.index;
+			// The main code addresses its slots from the
+			// bottom of the stack, routines from their frame:
+			const SizeType caller = graph.blocks[graph.regions[r].entry].begin;
+			if (caller) {
+				auto arity = arities.find(caller);
+				if (arity == arities.end()) continue;
+				site.slot += arity -> second;
+				site.frame = true;
+			}
+			if (site.slot < 0) continue;
+			sites.push_back(site);
+		}
+		if (sites.empty()) return;
+		inlined = sites.size();
+		Array<ByteCode> instructions;
+		instructions.reserve(size);
+		// New address of every instruction:
+		Array<SizeType> map(size + 1);
+		// Jumps of the copies, already in place:
+		Array<Boolean> placed;
+		placed.reserve(size);
+		SizeType next = 0;
+		for (SizeType i = 0; i < size; i += 1) {
+			map[i] = instructions.size();
+			// The SSF goes with its call:
+			if (next < sites.size() && sites[next].call == i + 1) continue;
+			if (next >= sites.size() || sites[next].call != i) {
+				instructions.push_back(codes[i]);
+				placed.push_back(false);
+				continue;
+			}
+			const Site & site = sites[next];
+			next += 1;
+			const Array<SizeType> & copied = bodies[site.entry];
+			SizeType count = copied.size();
+			if (codes[copied.back()].code == OPCode::RET) count -= 1;
+			const SizeType start = instructions.size();
+			const SizeType after = start + count;
+			auto place = [&] (SizeType target) {
+				const SizeType k = std::lower_bound(
+					copied.begin(), copied.end(), target
+				) - copied.begin();
+				return k < count ? start + k : after;
+			};
+			for (SizeType k = 0; k < count; k += 1) {
+				ByteCode byte = codes[copied[k]];
+				Boolean jumps = false;
+				switch (byte.code) {
+					case OPCode::GLF:
+						byte.code = site.frame ? OPCode::GLF : OPCode::GET;
+						byte.as.index += site.slot;
+					break;
+					case OPCode::SLF:
+						byte.code = site.frame ? OPCode::SLF : OPCode::SET;
+						byte.as.index += site.slot;
+					break;
+					case OPCode::RET:
+						byte.code = OPCode::JMP;
+						byte.as.index = after;
+						jumps = true;
+					break;
+					case OPCode::JMP: case OPCode::JIF:
+					case OPCode::JAF: case OPCode::JIT:
+					case OPCode::JAT:
+						byte.as.index = place(byte.as.index);
+						jumps = true;
+					break;
+					default: break;
+				}
+				instructions.push_back(byte);
+				placed.push_back(jumps);
+			}
+		}
+		map[size] = instructions.size();
+		for (SizeType i = 0; i < instructions.size(); i += 1) {
+			ByteCode & byte = instructions[i];
+			if (placed[i] || !Optimiser::addressed(byte.code)) continue;
+			if (byte.as.index <= size) byte.as.index = map[byte.as.index];
+		}
+		for (Program::Routine & routine : program -> routines) {
+			routine.address = map[routine.address];
+		}
+		program -> instructions = std::move(instructions);
+	}
+	inline void Compiler::specialise() {
+		// Typed operations on numbers are replaced with
+		// their specialised version, so that the processor
+		// doesn't need to switch on the operand types.
+		// Integer comparisons followed by a JIF (or a JIT)
+		// are fused into a single compare and jump:
+		const Array<Boolean> targets = Optimiser::targets(program);
+		const SizeType size = program -> instructions.size();
+		for (SizeType i = 0; i < size; i += 1) {
+			ByteCode & byte = program -> instructions[i];
+			switch (byte.code) {
+				case OPCode::ADD: case OPCode::SUB:
+				case OPCode::MUL: case OPCode::DIV:
+				case OPCode::MOD: case OPCode::EQL:
+				case OPCode::NEQ: case OPCode::GRT:
+				case OPCode::LSS: case OPCode::GEQ:
+				case OPCode::LEQ: break;
+				default: continue;
+			}
+			auto search = specialisedTable.find(
+				runtimeCompose(byte.code, byte.as.types)
+			);
+			if (search == specialisedTable.end()) continue;
+			byte.code = search -> second;
+			if (i + 1 >= size || targets[i + 1]) continue;
+			ByteCode & next = program -> instructions[i + 1];
+			if (next.code == OPCode::JIF) {
+				switch (byte.code) {
+					case OPCode::EQI: byte.code = OPCode::JNE; break;
+					case OPCode::NEI: byte.code = OPCode::JEQ; break;
+					case OPCode::GRI: byte.code = OPCode::JLE; break;
+					case OPCode::LSI: byte.code = OPCode::JGE; break;
+					case OPCode::GEI: byte.code = OPCode::JLS; break;
+					case OPCode::LEI: byte.code = OPCode::JGR; break;
+					default: continue;
+				}
+			} else if (next.code == OPCode::JIT) {
+				// Left by the peephole optimiser (NOT, JIF):
+				switch (byte.code) {
+					case OPCode::EQI: byte.code = OPCode::JEQ; break;
+					case OPCode::NEI: byte.code = OPCode::JNE; break;
+					case OPCode::GRI: byte.code = OPCode::JGR; break;
+					case OPCode::LSI: byte.code = OPCode::JLS; break;
+					case OPCode::GEI: byte.code = OPCode::JGE; break;
+					case OPCode::LEI: byte.code = OPCode::JLE; break;
+					default: continue;
+				}
+			} else continue;
+			byte.as.index = next.as.index;
+			next.code = OPCode::TRM;
+		}
+	}
+	inline void Compiler::fuse() {
+		// Frequent sequences are replaced with a single
+		// superinstruction. The sequences come from the
+		// n-gram mining tool (Tests/Tools/Grams.cpp) run
+		// on a corpus of programs. No instruction but the
+		// first can be the target of a jump:
+		const Array<Boolean> targets = Optimiser::targets(program);
+		Array<ByteCode> & codes = program -> instructions;
+		const SizeType size = codes.size();
+		auto matches = [&] (SizeType i, Array<OPCode> sequence) {
+			if (i + sequence.size() > size) return false;
+			for (SizeType j = 0; j < sequence.size(); j += 1) {
+				if (codes[i + j].code != sequence[j]) return false;
+				if (j > 0 && targets[i + j]) return false;
+			}
+			return true;
+		};
+		auto fits = [] (ByteCode a, ByteCode b) {
+			return a.as.index <= UINT32_MAX && (
+				b.code == OPCode::PSH ? (
+					b.as.value.integer >= INT32_MIN &&
+					b.as.value.integer <= INT32_MAX
+				) : b.as.index <= UINT32_MAX
+			);
+		};
+		auto replace = [&] (SizeType i, SizeType n, ByteCode byte) {
+			byte.line = codes[i].line;
+			codes[i] = byte;
+			for (SizeType j = 1; j < n; j += 1) {
+				codes[i + j].code = OPCode::TRM;
+			}
+		};
+		SizeType i = 0;
+		while (i < size) {
+			const ByteCode a = codes[i];
+			const ByteCode b = i + 1 < size ? codes[i + 1] : a;
+			const SizeType p = pack(a.as.index, b.as.index);
+			if (matches(i, { OPCode::GET, OPCode::PSH, OPCode::ADI, OPCode::SET, OPCode::POP }) &&
+				codes[i + 3].as.index == a.as.index && fits(a, b)) {
+				replace(i, 5, { OPCode::ICG, { .index = p } });
+				i += 5;
+			} else if (matches(i, { OPCode::GLF, OPCode::PSH, OPCode::ADI, OPCode::SLF, OPCode::POP }) &&
+					   codes[i + 3].as.index == a.as.index && fits(a, b)) {
+				replace(i, 5, { OPCode::ICF, { .index = p } });
+				i += 5;
+			} else if (matches(i, { OPCode::GET, OPCode::GET, OPCode::ADI }) && fits(a, b)) {
+				replace(i, 3, { OPCode::ADG, { .index = p } });
+				i += 3;
+			} else if (matches(i, { OPCode::GLF, OPCode::GLF, OPCode::ADI }) && fits(a, b)) {
+				replace(i, 3, { OPCode::ADF, { .index = p } });
+				i += 3;
+			} else if (matches(i, { OPCode::GET, OPCode::GET }) && fits(a, b)) {
+				replace(i, 2, { OPCode::GTT, { .index = p } });
+				i += 2;
+			} else if (matches(i, { OPCode::GLF, OPCode::GLF }) && fits(a, b)) {
+				replace(i, 2, { OPCode::GFT, { .index = p } });
+				i += 2;
+			} else if (matches(i, { OPCode::GET, OPCode::PSH }) && fits(a, b)) {
+				replace(i, 2, { OPCode::GTC, { .index = p } });
+				i += 2;
+			} else if (matches(i, { OPCode::GLF, OPCode::PSH }) && fits(a, b)) {
+				replace(i, 2, { OPCode::GFC, { .index = p } });
+				i += 2;
+			} else if (matches(i, { OPCode::SET, OPCode::POP })) {
+				replace(i, 2, { OPCode::SEP, { .index = a.as.index } });
+				i += 2;
+			} else if (matches(i, { OPCode::SLF, OPCode::POP })) {
+				replace(i, 2, { OPCode::SFP, { .index = a.as.index } });
+				i += 2;
+			} else i += 1;
+		}
+	}
+	inline void Compiler::resolveLamdas() {
+		for (ByteCode & byte : program -> instructions) {
+			if (byte.code == OPCode::TLT) byte.code = OPCode::PSH;
+		}
+	}
+	inline void Compiler::resolveLines() {
+		// Instructions that weren't emitted while parsing
+		// (eg: rests) belong to the line before them:
+		program -> files.push_back(* currentUnit -> name);
+		const SizeType size = program -> instructions.size();
+		UInt32 line = 0;
+		for (SizeType i = 0; i < size; i += 1) {
+			const UInt32 next = program -> instructions[i].line;
+			if (!next || next == line) continue;
+			program -> lines.push_back({ i, 0, next });
+			line = next;
+		}
+	}
 	inline SizeType Compiler::countLocals(SizeType scope) {
 		SizeType localCount = 0;
 		for (Int64 i = locals.size() - 1; i >= 0; i -= 1) {
@@ -3222,11 +3572,27 @@ namespace Spin {
 	inline SizeType Compiler::sourcePosition() {
 		return program -> instructions.size();
 	}
+	inline UInt32 Compiler::sourceLine() {
+		// Tokens are mostly asked for in order, so the
+		// count restarts only when going backwards:
+		const SizeType position = previous.position;
+		if (position < linePosition) {
+			linePosition = 0;
+			lineNumber = 1;
+		}
+		const String & contents = * currentUnit -> contents;
+		const SizeType end = std::min(position, contents.length());
+		for (; linePosition < end; linePosition += 1) {
+			if (contents[linePosition] == '\n') lineNumber += 1;
+		}
+		return lineNumber;
+	}
 	inline void Compiler::emitOperation(ByteCode code) {
+		if (!code.line) code.line = sourceLine();
 		program -> instructions.push_back(code);
 	}
 	inline void Compiler::emitOperation(OPCode code) {
-		program -> instructions.push_back({ code, {
+		emitOperation({ code, {
 			.value = { .integer = 0 } }
 		});
 	}
@@ -3255,7 +3621,8 @@ namespace Spin {
 		return count;
 	}
 	inline void Compiler::patchJumpNext(SizeType jmp) {
-		const SizeType jump = (sourcePosition() - jmp);
+		barrier = sourcePosition();
+		const SizeType jump = (barrier - jmp);
 		program -> instructions[jmp].as.index = jump;
 	}
 	inline void Compiler::patchJumpBack(SizeType pos, SizeType jmb) {
@@ -3328,9 +3695,16 @@ namespace Spin {
 		scopeDepth = 0;
 		cycleScopes.clear();
 		breakStack.clear();
+		continueStack.clear();
+		lamdaScopes.clear();
 		routineIndexes.clear();
 		strings.clear();
+		routines.clear();
 		prototypes.clear();
+		linePosition = 0;
+		lineNumber = 1;
+		barrier = 0;
+		arities.clear();
 		TypeNode::resetNodes();
 	}
 
@@ -3345,6 +3719,8 @@ namespace Spin {
 		tokens = source -> main -> tokens;
 		if (!tokens) return nullptr;
 		program = new Program();
+		removed = 0;
+		inlined = 0;
 
 		reset();
 		advance();
@@ -3362,11 +3738,23 @@ namespace Spin {
 		resolveRoutines();
 		resolveCalls();
 		resolveJumps();
+		if (options.inlining) inlineRoutines();
+		if (options.peephole) removed = Optimiser::optimise(program);
+		specialise();
+		if (options.fusing) fuse();
+		Optimiser::compact(program);
+		resolveLamdas();
+		resolveLines();
 
 		reset();
 
 		program -> instructions.shrink_to_fit();
 		program -> strings.shrink_to_fit();
+		// Measures its depths (see Processor::run), its
+		// operands are sound by construction even where
+		// the depths can't be told (lamda calls):
+		Verifier::verify(program);
+		program -> verified = true;
 
 		return program;
 	}
@@ -141,6 +141,8 @@ namespace Spin {
 			SizeType prototypeIndex = - 1;
 			SizeType frame = 0;
 			TypeNode * type = nullptr;
+			// Of the declaration:
+			UInt32 line = 0;
 		};
 
 		struct Parameter {
@@ -176,6 +178,19 @@ namespace Spin {
 		CodeUnit * currentUnit = nullptr;
 		Array<Token> * tokens = nullptr;
 
+		// Line of the previous token, counted from
+		// the last position that was asked for:
+		SizeType linePosition = 0;
+		UInt32 lineNumber = 1;
+
+		// Last target of a forward jump: operands
+		// before it are never folded:
+		SizeType barrier = 0;
+
+		// Parameters of every routine by address,
+		// kept by resolveRoutines for the inlining:
+		Dictionary<SizeType, SizeType> arities;
+
 		Array<Prototype> prototypes;
 		Stack<TypeNode *> typeStack;
 		Stack<Boolean> assignmentStack;
@@ -191,6 +206,7 @@ namespace Spin {
 		static const Dictionary<Unary, Type> prefixTable;
 		static const Dictionary<Unary, Type> postfixTable;
 		static const Dictionary<Types, Boolean> castTable;
+		static const Dictionary<Binary, OPCode> specialisedTable;
 
 		static consteval Unary compose(Token::Type token, Type type) {
 			return (Unary)(((Unary) token << 8) | type);
@@ -201,6 +217,9 @@ namespace Spin {
 		static consteval Types compose(Type a, Type b) {
 			return (Types)(((Types) a << 8) | b);
 		}
+		static consteval Binary compose(OPCode code, Type a, Type b) {
+			return (Binary)(((Binary) a << 16) | ((Binary) code << 8) | b);
+		}
 
 		ParseRule getRule(Token::Type token);
 
@@ -213,6 +232,9 @@ namespace Spin {
 		static inline Types runtimeCompose(Type a, Type b) {
 			return (Types)(((Types) a << 8) | b);
 		}
+		static inline Binary runtimeCompose(OPCode code, Types types) {
+			return (Binary)(((Binary)(types & 0xFF00) << 8) | ((Binary) code << 8) | (types & 0x00FF));
+		}
 		static inline Types runtimeCompose(Type a, UInt8 b) {
 			return (Types)(((Types) a << 8) | b);
 		}
@@ -285,8 +307,8 @@ namespace Spin {
 
 		void parsePrecedence(Precedence precedence);
 
-		void foldUnary(Token token);
-		void foldBinary(Token token);
+		// Replaces an operation on constants with its result:
+		void fold(Token token);
 
 		inline void pushType(Type type);
 		inline void pushType(TypeNode * node);
@@ -306,8 +328,14 @@ namespace Spin {
 		inline void resolveRoutines();
 		inline void resolveCalls();
 		inline void resolveJumps();
+		inline void inlineRoutines();
+		inline void specialise();
+		inline void fuse();
+		inline void resolveLamdas();
+		inline void resolveLines();
 		inline SizeType countLocals(SizeType scope);
 		inline SizeType sourcePosition();
+		inline UInt32 sourceLine();
 		inline void emitOperation(ByteCode code);
 		inline void emitOperation(OPCode code);
 		inline SizeType emitOperationIndex(OPCode code);
@@ -338,10 +366,21 @@ namespace Spin {
 		struct Options {
 			Boolean folding = true;
 			Boolean sectors = false;
+			Boolean fusing = true;
+			Boolean peephole = true;
+			// Largest routine (in instructions) copied
+			// in place of its calls, 0 turns it off:
+			SizeType inlining = 16;
 		};
 
 		Options options;
 
+		// Instructions removed by the peephole optimiser
+		// in the last compilation:
+		SizeType removed = 0;
+		// Calls replaced with their routine:
+		SizeType inlined = 0;
+
 		Compiler(const Compiler &) = delete;
 		Compiler(Compiler &&) = delete;
 		Compiler & operator = (const Compiler &) = delete;
@@ -21,8 +21,11 @@
 #ifndef SPIN_DECOMPILER_CPP
 #define SPIN_DECOMPILER_CPP
 
+#include <sstream>
 #include <vector>
 
+#include "Graph.hpp"
+
 #define reset "\x1B[0m"
 
 namespace Spin {
@@ -140,6 +143,23 @@ namespace Spin {
 				<< (UInt64)b << reset << colours[Colour::grey]
 				<< "                  ! " << h << endLine;
 	}
+	void Decompiler::pairOP(String o, SizeType x, Colour c, String h) {
+		if (na) {
+			OStream << "    " << o << "    "
+					<< upperCase << hexadecimal
+					<< padding(8) << high(x) << ", "
+					<< padding(8) << low(x)
+					<< "    ! " << h << endLine;
+			return;
+		}
+		OStream << "    " << colours[c] << o << reset
+				<< "    " << colours[Colour::acqua]
+				<< upperCase << hexadecimal
+				<< padding(8) << high(x) << reset << ", "
+				<< colours[Colour::acqua] << padding(8)
+				<< low(x) << reset << "    " << colours[Colour::grey]
+				<< "! " << h << reset << endLine;
+	}
 
 	void Decompiler::rest_OP() {
 		if (na) {
@@ -171,6 +191,117 @@ namespace Spin {
 		}
 	}
 
+	String Decompiler::mnemonic(OPCode code) {
+		switch (code) {
+			case OPCode::RST: return "RST";
+			case OPCode::PSH: return "PSH";
+			case OPCode::STR: return "STR";
+			case OPCode::TYP: return "TYP";
+			case OPCode::LLA: return "LLA";
+			case OPCode::ULA: return "ULA";
+			case OPCode::LAM: return "LAM";
+			case OPCode::GET: return "GET";
+			case OPCode::SET: return "SET";
+			case OPCode::SSF: return "SSF";
+			case OPCode::GLF: return "GLF";
+			case OPCode::SLF: return "SLF";
+			case OPCode::CTP: return "CTP";
+			case OPCode::LTP: return "LTP";
+			case OPCode::SWP: return "SWP";
+			case OPCode::ADD: return "ADD";
+			case OPCode::SUB: return "SUB";
+			case OPCode::MUL: return "MUL";
+			case OPCode::DIV: return "DIV";
+			case OPCode::MOD: return "MOD";
+			case OPCode::NEG: return "NEG";
+			case OPCode::INV: return "INV";
+			case OPCode::SGS: return "SGS";
+			case OPCode::SSS: return "SSS";
+			case OPCode::AGS: return "AGS";
+			case OPCode::ASS: return "ASS";
+			case OPCode::SCN: return "SCN";
+			case OPCode::ACN: return "ACN";
+			case OPCode::CCJ: return "CCJ";
+			case OPCode::VCJ: return "VCJ";
+			case OPCode::MCJ: return "MCJ";
+			case OPCode::PST: return "PST";
+			case OPCode::PSF: return "PSF";
+			case OPCode::PSI: return "PSI";
+			case OPCode::PSU: return "PSU";
+			case OPCode::PEC: return "PEC";
+			case OPCode::PES: return "PES";
+			case OPCode::PSA: return "PSA";
+			case OPCode::PEA: return "PEA";
+			case OPCode::POP: return "POP";
+			case OPCode::DHD: return "DHD";
+			case OPCode::DSK: return "DSK";
+			case OPCode::JMP: return "JMP";
+			case OPCode::JIF: return "JIF";
+			case OPCode::JAF: return "JAF";
+			case OPCode::JIT: return "JIT";
+			case OPCode::JAT: return "JAT";
+			case OPCode::EQL: return "EQL";
+			case OPCode::NEQ: return "NEQ";
+			case OPCode::GRT: return "GRT";
+			case OPCode::LSS: return "LSS";
+			case OPCode::GEQ: return "GEQ";
+			case OPCode::LEQ: return "LEQ";
+			case OPCode::NOT: return "NOT";
+			case OPCode::BWA: return "BWA";
+			case OPCode::BWO: return "BWO";
+			case OPCode::BWX: return "BWX";
+			case OPCode::BSR: return "BSR";
+			case OPCode::BSL: return "BSL";
+			case OPCode::BRR: return "BRR";
+			case OPCode::BRL: return "BRL";
+			case OPCode::CAL: return "CAL";
+			case OPCode::CLL: return "CLL";
+			case OPCode::RET: return "RET";
+			case OPCode::CST: return "CST";
+			case OPCode::INT: return "INT";
+			case OPCode::HLT: return "HLT";
+			case OPCode::ADI: return "ADI";
+			case OPCode::SBI: return "SBI";
+			case OPCode::MLI: return "MLI";
+			case OPCode::DVI: return "DVI";
+			case OPCode::MDI: return "MDI";
+			case OPCode::ADR: return "ADR";
+			case OPCode::SBR: return "SBR";
+			case OPCode::MLR: return "MLR";
+			case OPCode::DVR: return "DVR";
+			case OPCode::EQI: return "EQI";
+			case OPCode::NEI: return "NEI";
+			case OPCode::GRI: return "GRI";
+			case OPCode::LSI: return "LSI";
+			case OPCode::GEI: return "GEI";
+			case OPCode::LEI: return "LEI";
+			case OPCode::EQR: return "EQR";
+			case OPCode::NER: return "NER";
+			case OPCode::GRR: return "GRR";
+			case OPCode::LSR: return "LSR";
+			case OPCode::GER: return "GER";
+			case OPCode::LER: return "LER";
+			case OPCode::JEQ: return "JEQ";
+			case OPCode::JNE: return "JNE";
+			case OPCode::JGR: return "JGR";
+			case OPCode::JLS: return "JLS";
+			case OPCode::JGE: return "JGE";
+			case OPCode::JLE: return "JLE";
+			case OPCode::SEP: return "SEP";
+			case OPCode::SFP: return "SFP";
+			case OPCode::GTT: return "GTT";
+			case OPCode::GFT: return "GFT";
+			case OPCode::GTC: return "GTC";
+			case OPCode::GFC: return "GFC";
+			case OPCode::ADG: return "ADG";
+			case OPCode::ADF: return "ADF";
+			case OPCode::ICG: return "ICG";
+			case OPCode::ICF: return "ICF";
+			case OPCode::TCL: return "TCL";
+			default: return "UNK";
+		}
+	}
+
 	void Decompiler::decompile(Program * program, SizeType index) {
 		const ByteCode byte = program -> instructions.at(index);
 		if (na) {
@@ -248,19 +379,181 @@ namespace Spin {
 			case OPCode::CST: typesOP("CST", byte.as.types, Colour::orange, "cast"); break;
 			case OPCode::INT: smallOP("INT", byte.as.type, Colour::peach, "interrupt"); break;
 			case OPCode::HLT: aloneOP("HLT", Colour::red, "halt"); break;
+			case OPCode::ADI: aloneOP("ADI", Colour::blue, "integer addition"); break;
+			case OPCode::SBI: aloneOP("SBI", Colour::blue, "integer subtraction"); break;
+			case OPCode::MLI: aloneOP("MLI", Colour::blue, "integer multiplication"); break;
+			case OPCode::DVI: aloneOP("DVI", Colour::blue, "integer division"); break;
+			case OPCode::MDI: aloneOP("MDI", Colour::blue, "integer modulus"); break;
+			case OPCode::ADR: aloneOP("ADR", Colour::blue, "real addition"); break;
+			case OPCode::SBR: aloneOP("SBR", Colour::blue, "real subtraction"); break;
+			case OPCode::MLR: aloneOP("MLR", Colour::blue, "real multiplication"); break;
+			case OPCode::DVR: aloneOP("DVR", Colour::blue, "real division"); break;
+			case OPCode::EQI: aloneOP("EQI", Colour::orange, "integer equal"); break;
+			case OPCode::NEI: aloneOP("NEI", Colour::orange, "integer not equal"); break;
+			case OPCode::GRI: aloneOP("GRI", Colour::orange, "integer great"); break;
+			case OPCode::LSI: aloneOP("LSI", Colour::orange, "integer less"); break;
+			case OPCode::GEI: aloneOP("GEI", Colour::orange, "integer great equal"); break;
+			case OPCode::LEI: aloneOP("LEI", Colour::orange, "integer less equal"); break;
+			case OPCode::EQR: aloneOP("EQR", Colour::orange, "real equal"); break;
+			case OPCode::NER: aloneOP("NER", Colour::orange, "real not equal"); break;
+			case OPCode::GRR: aloneOP("GRR", Colour::orange, "real great"); break;
+			case OPCode::LSR: aloneOP("LSR", Colour::orange, "real less"); break;
+			case OPCode::GER: aloneOP("GER", Colour::orange, "real great equal"); break;
+			case OPCode::LER: aloneOP("LER", Colour::orange, "real less equal"); break;
+			case OPCode::JEQ: jmptoOP("JEQ", byte.as.index, "jump if equal"); break;
+			case OPCode::JNE: jmptoOP("JNE", byte.as.index, "jump if not equal"); break;
+			case OPCode::JGR: jmptoOP("JGR", byte.as.index, "jump if great"); break;
+			case OPCode::JLS: jmptoOP("JLS", byte.as.index, "jump if less"); break;
+			case OPCode::JGE: jmptoOP("JGE", byte.as.index, "jump if great equal"); break;
+			case OPCode::JLE: jmptoOP("JLE", byte.as.index, "jump if less equal"); break;
+			case OPCode::SEP: constOP("SEP", byte.as.index, Colour::purple); break;
+			case OPCode::SFP: constOP("SFP", byte.as.index, Colour::purple); break;
+			case OPCode::GTT: pairOP("GTT", byte.as.index, Colour::purple, "get two locals"); break;
+			case OPCode::GFT: pairOP("GFT", byte.as.index, Colour::purple, "get two locals from frame"); break;
+			case OPCode::GTC: pairOP("GTC", byte.as.index, Colour::purple, "get local, push constant"); break;
+			case OPCode::GFC: pairOP("GFC", byte.as.index, Colour::purple, "get local from frame, push constant"); break;
+			case OPCode::ADG: pairOP("ADG", byte.as.index, Colour::blue, "integer addition of locals"); break;
+			case OPCode::ADF: pairOP("ADF", byte.as.index, Colour::blue, "integer addition of frame locals"); break;
+			case OPCode::ICG: pairOP("ICG", byte.as.index, Colour::blue, "integer increment of local"); break;
+			case OPCode::ICF: pairOP("ICF", byte.as.index, Colour::blue, "integer increment of frame local"); break;
+			case OPCode::TCL: jmptoOP("TCL", byte.as.index, "tail call"); break;
 			default: break;
 		}
 		OStream << decimal;
 	}
+	void Decompiler::source(Program * program, SizeType index) {
+		const Program::Routine * routine = program -> routine(index);
+		if (routine && routine -> address == index) {
+			if (na) OStream << routine -> name << ":" << endLine;
+			else {
+				OStream << colours[Colour::sky] << routine -> name
+						<< ":" << reset << endLine;
+			}
+		}
+		const Program::Line * line = program -> locate(index);
+		if (!line || line -> address != index) return;
+		if (na) {
+			OStream << "            ! line " << decimal << line -> line
+					<< " of ['" << program -> files[line -> file]
+					<< "']" << endLine;
+			return;
+		}
+		OStream << "            " << colours[Colour::grey] << "! line "
+				<< decimal << line -> line << " of ['"
+				<< program -> files[line -> file] << "']"
+				<< reset << endLine;
+	}
+
 	void Decompiler::decompile(Program * program, Boolean noAnsi) {
 		OStream << endLine;
 		na = noAnsi;
 		for (SizeType i = 0; i < program -> instructions.size(); i += 1) {
+			source(program, i);
 			decompile(program, i);
 		}
 		OStream << endLine;
 	}
 
+
+	// Escapes quotes and backslashes of DOT labels:
+	static String escape(const String & text) {
+		String escaped;
+		for (Character c : text) {
+			if (c == '"' || c == '\\') escaped += '\\';
+			if (c == '\n') escaped += "\\n";
+			else escaped += c;
+		}
+		return escaped;
+	}
+
+	String Decompiler::label(Program * program, SizeType index) {
+		const ByteCode & byte = program -> instructions[index];
+		std::stringstream line;
+		line << upperCase << hexadecimal << padding(8) << index
+			 << "  " << mnemonic(byte.code);
+		switch (byte.code) {
+			case OPCode::STR: {
+				String string = program -> strings.at(byte.as.index);
+				if (string.length() > 16) string = string.substr(0, 15) + "...";
+				line << "  \"" << escape(string) << "\"";
+			} break;
+			case OPCode::PSH: line << "  " << byte.as.value.integer; break;
+			case OPCode::GET: case OPCode::SET: case OPCode::SSF:
+			case OPCode::GLF: case OPCode::SLF: case OPCode::PSA:
+			case OPCode::DSK: case OPCode::SEP: case OPCode::SFP:
+				line << "  " << byte.as.index;
+			break;
+			case OPCode::JMP: case OPCode::JIF: case OPCode::JAF:
+			case OPCode::JIT: case OPCode::JAT: case OPCode::JEQ:
+			case OPCode::JNE: case OPCode::JGR: case OPCode::JLS:
+			case OPCode::JGE: case OPCode::JLE: case OPCode::CAL:
+			case OPCode::TCL:
+				line << "  " << padding(8) << byte.as.index;
+			break;
+			case OPCode::GTT: case OPCode::GFT: case OPCode::GTC:
+			case OPCode::GFC: case OPCode::ADG: case OPCode::ADF:
+			case OPCode::ICG: case OPCode::ICF:
+				line << "  " << high(byte.as.index) << ", " << low(byte.as.index);
+			break;
+			case OPCode::INT: line << "  " << (UInt64) byte.as.type; break;
+			default: break;
+		}
+		return line.str();
+	}
+
+	void Decompiler::graph(Program * program) {
+		// Lamdas are only known from the routines:
+		program -> expand();
+		Graph graph(program);
+		graph.measure();
+		const Array<ByteCode> & codes = program -> instructions;
+		auto node = [&] (SizeType b) {
+			const Graph::Block & block = graph.blocks[b];
+			OStream << "\t\tb" << decimal << b << " [label = \"";
+			if (block.depth != Graph::unknown) {
+				OStream << "depth " << decimal << block.depth << "\\l";
+			}
+			for (SizeType i = block.begin; i < block.end; i += 1) {
+				OStream << label(program, i) << "\\l";
+			}
+			OStream << "\"";
+			if (block.region == Graph::none) OStream << ", style = dashed";
+			OStream << "];" << endLine;
+		};
+		OStream << "digraph spin {" << endLine
+				<< "\tnode [shape = box, fontname = \"monospace\"];" << endLine;
+		for (SizeType r = 0; r < graph.regions.size(); r += 1) {
+			const Graph::Region & region = graph.regions[r];
+			const SizeType entry = graph.blocks[region.entry].begin;
+			const Program::Routine * routine = program -> routine(entry);
+			OStream << "\tsubgraph cluster" << decimal << r << " {" << endLine
+					<< "\t\tlabel = \"";
+			if (routine && routine -> address == entry) {
+				OStream << escape(routine -> name);
+			} else OStream << upperCase << hexadecimal << padding(8) << entry;
+			OStream << "\";" << endLine;
+			for (SizeType b : region.order) node(b);
+			OStream << "\t}" << endLine;
+		}
+		// Unreachable code, out of every routine:
+		for (SizeType b = 0; b < graph.blocks.size(); b += 1) {
+			if (graph.blocks[b].region == Graph::none) node(b);
+		}
+		for (SizeType b = 0; b < graph.blocks.size(); b += 1) {
+			const Graph::Block & block = graph.blocks[b];
+			for (SizeType s : block.successors) {
+				OStream << "\tb" << decimal << b << " -> b" << s << ";" << endLine;
+			}
+			const ByteCode & last = codes[block.end - 1];
+			if (last.code != OPCode::CAL && last.code != OPCode::TCL) continue;
+			if (last.as.index >= codes.size()) continue;
+			OStream << "\tb" << decimal << b << " -> b"
+					<< graph.owners[last.as.index]
+					<< " [style = dashed];" << endLine;
+		}
+		OStream << "}" << endLine << decimal;
+	}
+
 }
 
 #undef reset
@@ -38,10 +38,15 @@ namespace Spin {
 		static void unaryOP(String o, Type x, Colour c, String h);
 		static void jmptoOP(String o, SizeType x, String h);
 		static void smallOP(String o, Byte b, Colour c, String h);
+		static void pairOP(String o, SizeType x, Colour c, String h);
 
 		static void rest_OP();
-		
-		static String resolve(Type type);
+
+		// Routines and lines starting at an address:
+		static void source(Program * program, SizeType index);
+
+		// Instruction as a line of a node of the graph:
+		static String label(Program * program, SizeType index);
 
 		static inline Boolean na = false;
 
@@ -49,9 +54,16 @@ namespace Spin {
 
 		Decompiler() = delete;
 
+		static String mnemonic(OPCode code);
+		static String resolve(Type type);
+
 		static void decompile(Program * program, SizeType index);
 		static void decompile(Program * program, Boolean noAnsi = false);
 
+		// Control flow graph in DOT (see Graph.hpp),
+		// a cluster for every routine:
+		static void graph(Program * program);
+
 	};
 
 }
@@ -0,0 +1,98 @@
+
+/*!
+ *
+ *    + --------------------------------------- +
+ *    |  Evaluator.cpp                          |
+ *    |                                         |
+ *    |           Constant Evaluator            |
+ *    |                                         |
+ *    |  Created by Cristian A.                 |
+ *    |  Copyright © MIT. All rights reserved.  |
+ *    + --------------------------------------- +
+ *
+ *    Note: This software is licensed under
+ *          the (MIT) Massachusetts Institute
+ *          of Technology License.
+ *
+!*/
+
+#include "Evaluator.hpp"
+
+#ifndef SPIN_EVALUATOR_CPP
+#define SPIN_EVALUATOR_CPP
+
+#include <limits>
+
+#include "../Virtual/Operations.hpp"
+
+namespace Spin {
+
+	SizeType Evaluator::arity(const ByteCode & operation) {
+		switch (operation.code) {
+			case OPCode::NEG: case OPCode::INV:
+			case OPCode::NOT: case OPCode::CST: return 1;
+			case OPCode::ADD: case OPCode::SUB:
+			case OPCode::MUL: case OPCode::DIV:
+			case OPCode::MOD: case OPCode::EQL:
+			case OPCode::NEQ: case OPCode::GRT:
+			case OPCode::LSS: case OPCode::GEQ:
+			case OPCode::LEQ: case OPCode::BWA:
+			case OPCode::BWO: case OPCode::BWX:
+			case OPCode::BSR: case OPCode::BSL:
+			case OPCode::BRR: case OPCode::BRL: return 2;
+			default: return 0;
+		}
+	}
+
+	Boolean Evaluator::constant(const ByteCode & code, Value & value) {
+		switch (code.code) {
+			case OPCode::PSH: value = code.as.value; return true;
+			case OPCode::PST: value = { .boolean = true }; return true;
+			case OPCode::PSF: value = { .boolean = false }; return true;
+			case OPCode::PSI:
+				value = { .real = std::numeric_limits<Real>::infinity() };
+			return true;
+			case OPCode::PSU:
+				value = { .real = std::numeric_limits<Real>::quiet_NaN() };
+			return true;
+			default: return false;
+		}
+	}
+
+	Boolean Evaluator::evaluate(const ByteCode & operation,
+								const Value * operands, Value & result) {
+		const Value a = operands[0];
+		const Value b = arity(operation) > 1 ? operands[1] : Value { };
+		const Type type = operation.as.type;
+		const Types types = operation.as.types;
+		const auto invalid = [] { throw Invalid(); };
+		switch (operation.code) {
+			case OPCode::NEG: return Operations::negate(type, a, result);
+			case OPCode::INV: return Operations::invert(type, a, result);
+			case OPCode::NOT: result = { .boolean = !a.boolean }; return true;
+			case OPCode::CST: return Operations::cast(types, a, result);
+			case OPCode::ADD: return Operations::add(types, a, b, result);
+			case OPCode::SUB: return Operations::subtract(types, a, b, result);
+			case OPCode::MUL: return Operations::multiply(types, a, b, result);
+			case OPCode::DIV: return Operations::divide(types, a, b, result, invalid);
+			case OPCode::MOD: return Operations::modulo(types, a, b, result, invalid);
+			case OPCode::EQL: return Operations::equal(types, a, b, result);
+			case OPCode::NEQ: return Operations::different(types, a, b, result);
+			case OPCode::GRT: return Operations::greater(types, a, b, result);
+			case OPCode::LSS: return Operations::less(types, a, b, result);
+			case OPCode::GEQ: return Operations::greaterEqual(types, a, b, result);
+			case OPCode::LEQ: return Operations::lessEqual(types, a, b, result);
+			case OPCode::BWA: return Operations::bitwiseAnd(types, a, b, result);
+			case OPCode::BWO: return Operations::bitwiseOr(types, a, b, result);
+			case OPCode::BWX: return Operations::bitwiseXor(types, a, b, result);
+			case OPCode::BSR: return Operations::shiftRight(type, a, b, result);
+			case OPCode::BSL: return Operations::shiftLeft(type, a, b, result);
+			case OPCode::BRR: return Operations::rotateRight(type, a, b, result);
+			case OPCode::BRL: return Operations::rotateLeft(type, a, b, result);
+			default: return false;
+		}
+	}
+
+}
+
+#endif
@@ -0,0 +1,39 @@
+
+#include "../Common/Header.hpp"
+
+#ifndef SPIN_EVALUATOR_HPP
+#define SPIN_EVALUATOR_HPP
+
+#include "Program.hpp"
+
+namespace Spin {
+
+	// Constant folding of the compiler: evaluates an
+	// operation whose operands are all constants with
+	// the Operations of the engines, on plain values,
+	// without a Processor and without allocating.
+	// Operations producing objects (Complex...) are
+	// left to the runtime.
+
+	class Evaluator {
+
+		public:
+
+		// The operation would crash at runtime:
+		class Invalid: Exception { };
+
+		Evaluator() = delete;
+
+		// Operands of a foldable operation, 0 otherwise:
+		static SizeType arity(const ByteCode & operation);
+		// Value pushed by a constant instruction:
+		static Boolean constant(const ByteCode & code, Value & value);
+		// False when it can't be folded:
+		static Boolean evaluate(const ByteCode & operation,
+								const Value * operands, Value & result);
+
+	};
+
+}
+
+#endif
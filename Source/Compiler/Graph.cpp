@@ -0,0 +1,591 @@
+
+/*!
+ *
+ *    + --------------------------------------- +
+ *    |  Graph.cpp                              |
+ *    |                                         |
+ *    |           Control Flow Graph            |
+ *    |                                         |
+ *    |  Created by Cristian A.                 |
+ *    |  Copyright © MIT. All rights reserved.  |
+ *    + --------------------------------------- +
+ *
+ *    Note: This software is licensed under
+ *          the (MIT) Massachusetts Institute
+ *          of Technology License.
+ *
+!*/
+
+#include "Graph.hpp"
+
+#ifndef SPIN_GRAPH_CPP
+#define SPIN_GRAPH_CPP
+
+#include <algorithm>
+#include <iterator>
+
+namespace Spin {
+
+	void Graph::Bits::reset(SizeType from, SizeType to) {
+		from -= base; to -= base;
+		while (from < to && (from & 63)) {
+			words[from >> 6] &= ~((UInt64) 1 << (from & 63));
+			from += 1;
+		}
+		while (from + 64 <= to) {
+			words[from >> 6] = 0;
+			from += 64;
+		}
+		while (from < to) {
+			words[from >> 6] &= ~((UInt64) 1 << (from & 63));
+			from += 1;
+		}
+	}
+	Boolean Graph::Bits::merge(const Bits & other) {
+		Boolean changed = false;
+		for (SizeType i = 0; i < words.size(); i += 1) {
+			const UInt64 word = words[i] | other.words[i];
+			changed |= word != words[i];
+			words[i] = word;
+		}
+		return changed;
+	}
+
+	static inline Boolean conditional(OPCode code) {
+		switch (code) {
+			case OPCode::JIF: case OPCode::JAF:
+			case OPCode::JIT: case OPCode::JAT:
+			case OPCode::JEQ: case OPCode::JNE:
+			case OPCode::JGR: case OPCode::JLS:
+			case OPCode::JGE: case OPCode::JLE:
+				return true;
+			default: return false;
+		}
+	}
+	static inline Boolean terminates(OPCode code) {
+		switch (code) {
+			case OPCode::JMP: case OPCode::CAL:
+			case OPCode::LAM: case OPCode::RET:
+			case OPCode::TCL: case OPCode::HLT:
+				return true;
+			default: return conditional(code);
+		}
+	}
+
+	// The routines of a debug section still pending
+	// aren't decoded (see Program::expand): only the
+	// ones reached by calls start their own regions:
+	Graph::Graph(Program * program): program(program) {
+		partition();
+		connect();
+		order();
+	}
+
+	void Graph::partition() {
+		const Array<ByteCode> & codes = program -> instructions;
+		const SizeType size = codes.size();
+		Array<Boolean> leaders(size + 1, false);
+		leaders[0] = true;
+		for (const Program::Routine & routine : program -> routines) {
+			if (routine.address < size) leaders[routine.address] = true;
+		}
+		for (SizeType i = 0; i < size; i += 1) {
+			const OPCode code = codes[i].code;
+			if (terminates(code)) leaders[i + 1] = true;
+			if (code == OPCode::JMP || code == OPCode::CAL ||
+				code == OPCode::TCL || conditional(code)) {
+				if (codes[i].as.index < size) leaders[codes[i].as.index] = true;
+			}
+		}
+		owners = Array<SizeType>(size, none);
+		for (SizeType i = 0; i < size; i += 1) {
+			if (leaders[i]) {
+				blocks.push_back(Block());
+				blocks.back().begin = i;
+			}
+			blocks.back().end = i + 1;
+			owners[i] = blocks.size() - 1;
+		}
+	}
+
+	void Graph::connect() {
+		const Array<ByteCode> & codes = program -> instructions;
+		const SizeType size = codes.size();
+		for (SizeType b = 0; b < blocks.size(); b += 1) {
+			Block & block = blocks[b];
+			const ByteCode & last = codes[block.end - 1];
+			// Jumps out of the code end the program:
+			if (last.code == OPCode::JMP || conditional(last.code)) {
+				if (last.as.index < size) {
+					block.successors.push_back(owners[last.as.index]);
+				}
+			}
+			switch (last.code) {
+				// Tail calls return for their routine:
+				case OPCode::JMP: case OPCode::RET:
+				case OPCode::TCL: case OPCode::HLT: break;
+				default:
+					// Calls return to the next instruction:
+					if (block.end >= size) break;
+					if (!block.successors.empty() &&
+						block.successors[0] == b + 1) break;
+					block.successors.push_back(b + 1);
+			}
+			for (SizeType s : block.successors) {
+				blocks[s].predecessors.push_back(b);
+			}
+		}
+	}
+
+	void Graph::order() {
+		if (blocks.empty()) return;
+		const Array<ByteCode> & codes = program -> instructions;
+		const SizeType size = codes.size();
+		// The main code first, then every routine:
+		Array<SizeType> roots;
+		for (const Program::Routine & routine : program -> routines) {
+			if (routine.address < size) roots.push_back(owners[routine.address]);
+		}
+		for (const ByteCode & byte : codes) {
+			if (byte.code != OPCode::CAL && byte.code != OPCode::TCL) continue;
+			if (byte.as.index >= size) continue;
+			roots.push_back(owners[byte.as.index]);
+		}
+		std::sort(roots.begin(), roots.end());
+		roots.erase(std::unique(roots.begin(), roots.end()), roots.end());
+		if (roots.empty() || roots[0] != 0) roots.insert(roots.begin(), 0);
+		// Depth first, without recursion:
+		Array<Pair<SizeType, SizeType>> stack;
+		for (SizeType root : roots) {
+			if (blocks[root].region != none) continue;
+			const SizeType r = regions.size();
+			Region region;
+			region.entry = root;
+			blocks[root].region = r;
+			stack.push_back({ root, 0 });
+			while (!stack.empty()) {
+				const SizeType b = stack.back().first;
+				const SizeType next = stack.back().second;
+				if (next < blocks[b].successors.size()) {
+					stack.back().second += 1;
+					const SizeType s = blocks[b].successors[next];
+					if (blocks[s].region != none) continue;
+					blocks[s].region = r;
+					stack.push_back({ s, 0 });
+					continue;
+				}
+				region.order.push_back(b);
+				stack.pop_back();
+			}
+			std::reverse(region.order.begin(), region.order.end());
+			regions.push_back(std::move(region));
+		}
+	}
+
+	Int64 Graph::effect(const Array<ByteCode> & codes, SizeType i) {
+		const ByteCode & byte = codes[i];
+		switch (byte.code) {
+			case OPCode::RST: case OPCode::SSF: case OPCode::SET:
+			case OPCode::SLF: case OPCode::ICG: case OPCode::ICF:
+			case OPCode::JMP: case OPCode::JAF: case OPCode::JAT:
+			case OPCode::NOT: case OPCode::NEG: case OPCode::INV:
+			case OPCode::CST: case OPCode::CCJ: case OPCode::VCJ:
+			case OPCode::MCJ: case OPCode::SCN: case OPCode::ACN:
+			case OPCode::CLL: case OPCode::RET: case OPCode::HLT:
+			case OPCode::TCL: case OPCode::TRM:
+				return 0;
+			case OPCode::PSH: case OPCode::STR: case OPCode::TYP:
+			case OPCode::ULA: case OPCode::GET: case OPCode::GLF:
+			case OPCode::LTP: case OPCode::PST: case OPCode::PSF:
+			case OPCode::PSI: case OPCode::PSU: case OPCode::PEC:
+			case OPCode::PES: case OPCode::PEA: case OPCode::DHD:
+			case OPCode::ADG: case OPCode::ADF: case OPCode::TLT:
+				return 1;
+			case OPCode::GTT: case OPCode::GFT:
+			case OPCode::GTC: case OPCode::GFC:
+				return 2;
+			case OPCode::LLA: case OPCode::CTP: case OPCode::POP:
+			case OPCode::JIF: case OPCode::JIT: case OPCode::SEP:
+			case OPCode::SFP: case OPCode::SGS: case OPCode::AGS:
+			case OPCode::ADD: case OPCode::SUB: case OPCode::MUL:
+			case OPCode::DIV: case OPCode::MOD: case OPCode::EQL:
+			case OPCode::NEQ: case OPCode::GRT: case OPCode::LSS:
+			case OPCode::GEQ: case OPCode::LEQ: case OPCode::BWA:
+			case OPCode::BWO: case OPCode::BWX: case OPCode::BSR:
+			case OPCode::BSL: case OPCode::BRR: case OPCode::BRL:
+			case OPCode::ADI: case OPCode::SBI: case OPCode::MLI:
+			case OPCode::DVI: case OPCode::MDI: case OPCode::ADR:
+			case OPCode::SBR: case OPCode::MLR: case OPCode::DVR:
+			case OPCode::EQI: case OPCode::NEI: case OPCode::GRI:
+			case OPCode::LSI: case OPCode::GEI: case OPCode::LEI:
+			case OPCode::EQR: case OPCode::NER: case OPCode::GRR:
+			case OPCode::LSR: case OPCode::GER: case OPCode::LER:
+				return -1;
+			case OPCode::SWP: case OPCode::SSS: case OPCode::ASS:
+			case OPCode::JEQ: case OPCode::JNE: case OPCode::JGR:
+			case OPCode::JLS: case OPCode::JGE: case OPCode::JLE:
+				return -2;
+			case OPCode::DSK: return - (Int64) byte.as.index;
+			case OPCode::PSA: return 1 - (Int64) byte.as.index;
+			case OPCode::INT:
+				switch ((Interrupt) byte.as.type) {
+					case Interrupt::write:
+					case Interrupt::writeln: return -2;
+					case Interrupt::sleep: return -1;
+					case Interrupt::read: case Interrupt::readln:
+					case Interrupt::clock: case Interrupt::noise:
+						return 1;
+					default: return unknown;
+				}
+			default: return unknown;
+		}
+	}
+	Int64 Graph::step(SizeType i) const {
+		const ByteCode & byte = program -> instructions[i];
+		if (byte.code != OPCode::CAL) return effect(program -> instructions, i);
+		if (byte.as.index >= owners.size()) return unknown;
+		const SizeType region = blocks[owners[byte.as.index]].region;
+		return region == none ? unknown : regions[region].result;
+	}
+
+	void Graph::dominate() {
+		// Position of the blocks in reverse postorder:
+		Array<SizeType> number(blocks.size(), none);
+		for (Block & block : blocks) block.dominator = none;
+		for (const Region & region : regions) {
+			const Array<SizeType> & order = region.order;
+			for (SizeType i = 0; i < order.size(); i += 1) {
+				number[order[i]] = i;
+			}
+			blocks[region.entry].dominator = region.entry;
+			// Cooper, Harvey and Kennedy:
+			Boolean changed = true;
+			while (changed) {
+				changed = false;
+				for (SizeType i = 1; i < order.size(); i += 1) {
+					Block & block = blocks[order[i]];
+					SizeType dominator = none;
+					for (SizeType p : block.predecessors) {
+						if (blocks[p].dominator == none) continue;
+						if (dominator == none) { dominator = p; continue; }
+						SizeType a = p, b = dominator;
+						while (a != b) {
+							while (number[a] > number[b]) a = blocks[a].dominator;
+							while (number[b] > number[a]) b = blocks[b].dominator;
+						}
+						dominator = a;
+					}
+					if (dominator == block.dominator) continue;
+					block.dominator = dominator;
+					changed = true;
+				}
+			}
+		}
+	}
+	Boolean Graph::dominates(SizeType a, SizeType b) const {
+		while (b != none) {
+			if (a == b) return true;
+			const SizeType dominator = blocks[b].dominator;
+			if (dominator == b) return false;
+			b = dominator;
+		}
+		return false;
+	}
+
+	Boolean Graph::measure() {
+		const Array<ByteCode> & codes = program -> instructions;
+		for (Region & region : regions) region.result = unknown;
+		// Callers wait for the result of their callees,
+		// recursive routines find it on the paths that
+		// return without calling themselves (tail calls
+		// end their path, the callee returns for them):
+		Array<Array<SizeType>> waiting(regions.size());
+		Array<SizeType> pending;
+		for (SizeType r = regions.size(); r > 0; r -= 1) pending.push_back(r - 1);
+		Boolean consistent = true;
+		while (!pending.empty()) {
+			const SizeType r = pending.back();
+			pending.pop_back();
+			Region & region = regions[r];
+			for (SizeType b : region.order) blocks[b].depth = unknown;
+			blocks[region.entry].depth = 0;
+			for (SizeType b : region.order) {
+				Block & block = blocks[b];
+				if (block.depth == unknown) continue;
+				Int64 depth = block.depth;
+				for (SizeType i = block.begin; i < block.end && depth != unknown; i += 1) {
+					const Int64 effect = step(i);
+					if (effect == unknown && codes[i].code == OPCode::CAL &&
+						codes[i].as.index < owners.size()) {
+						const SizeType callee = blocks[owners[codes[i].as.index]].region;
+						if (callee != none) waiting[callee].push_back(r);
+					}
+					if (codes[i].code == OPCode::RET) {
+						if (region.result == unknown) {
+							region.result = depth;
+							for (SizeType caller : waiting[r]) pending.push_back(caller);
+							waiting[r].clear();
+						} else consistent &= region.result == depth;
+					}
+					depth = effect == unknown ? unknown : depth + effect;
+				}
+				if (depth == unknown) continue;
+				for (SizeType s : block.successors) {
+					if (blocks[s].depth == unknown) blocks[s].depth = depth;
+					else consistent &= blocks[s].depth == depth;
+				}
+			}
+		}
+		for (const Block & block : blocks) {
+			if (block.region != none && block.depth == unknown) return false;
+		}
+		return consistent;
+	}
+	Int64 Graph::depth(SizeType address) const {
+		Int64 depth = blocks[owners[address]].depth;
+		for (SizeType i = blocks[owners[address]].begin; i < address; i += 1) {
+			if (depth == unknown) break;
+			const Int64 effect = step(i);
+			depth = effect == unknown ? unknown : depth + effect;
+		}
+		return depth;
+	}
+
+	// Slots are keyed by their index and frame flag:
+	static inline UInt64 global(SizeType index) { return (UInt64) index << 1; }
+	static inline UInt64 local(SizeType index) { return ((UInt64) index << 1) | 1; }
+
+	Graph::Access Graph::access(const ByteCode & byte) {
+		Access access;
+		switch (byte.code) {
+			case OPCode::GET: access.reads = 1; access.read[0] = global(byte.as.index); break;
+			case OPCode::GLF: access.reads = 1; access.read[0] = local(byte.as.index); break;
+			case OPCode::GTC: access.reads = 1; access.read[0] = global(high(byte.as.index)); break;
+			case OPCode::GFC: access.reads = 1; access.read[0] = local(high(byte.as.index)); break;
+			case OPCode::GTT: case OPCode::ADG:
+				access.reads = 2;
+				access.read[0] = global(high(byte.as.index));
+				access.read[1] = global(low(byte.as.index));
+			break;
+			case OPCode::GFT: case OPCode::ADF:
+				access.reads = 2;
+				access.read[0] = local(high(byte.as.index));
+				access.read[1] = local(low(byte.as.index));
+			break;
+			case OPCode::SET: case OPCode::SEP:
+				access.writes = true; access.write = global(byte.as.index);
+			break;
+			case OPCode::SLF: case OPCode::SFP:
+				access.writes = true; access.write = local(byte.as.index);
+			break;
+			case OPCode::ICG:
+				access.reads = 1; access.read[0] = global(high(byte.as.index));
+				access.writes = true; access.write = access.read[0];
+			break;
+			case OPCode::ICF:
+				access.reads = 1; access.read[0] = local(high(byte.as.index));
+				access.writes = true; access.write = access.read[0];
+			break;
+			default: break;
+		}
+		return access;
+	}
+	Boolean Graph::opaque(OPCode code) {
+		switch (code) {
+			case OPCode::CAL: case OPCode::LAM:
+			case OPCode::RET: case OPCode::TCL:
+				return true;
+			default: return false;
+		}
+	}
+
+	SizeType Graph::variable(SizeType region, UInt64 slot) const {
+		return slots[region].at(slot);
+	}
+
+	void Graph::collect() {
+		if (!slots.empty() || regions.empty()) return;
+		const Array<ByteCode> & codes = program -> instructions;
+		slots = Array<Dictionary<UInt64, SizeType>>(regions.size());
+		// Variables, numbered a region at a time:
+		Array<SizeType> counts;
+		for (SizeType r = 0; r < regions.size(); r += 1) {
+			Region & region = regions[r];
+			Dictionary<UInt64, SizeType> & map = slots[r];
+			region.first = variables.size();
+			auto add = [&] (UInt64 slot) {
+				auto found = map.find(slot);
+				if (found != map.end()) return found -> second;
+				const SizeType v = variables.size();
+				map[slot] = v;
+				variables.push_back({ r, (slot & 1) != 0, (SizeType)(slot >> 1) });
+				// The clobber of the variable:
+				counts.push_back(1);
+				return v;
+			};
+			for (SizeType b : region.order) {
+				for (SizeType i = blocks[b].begin; i < blocks[b].end; i += 1) {
+					const Access access = Graph::access(codes[i]);
+					for (SizeType k = 0; k < access.reads; k += 1) add(access.read[k]);
+					if (access.writes) counts[add(access.write)] += 1;
+				}
+			}
+			region.count = variables.size() - region.first;
+		}
+		// Definitions, grouped by variable:
+		starts = Array<SizeType>(variables.size() + 1, 0);
+		for (SizeType v = 0; v < variables.size(); v += 1) {
+			starts[v + 1] = starts[v] + counts[v];
+		}
+		definitions = Array<Definition>(starts.back());
+		sites = Array<SizeType>(codes.size(), none);
+		for (SizeType v = 0; v < variables.size(); v += 1) {
+			definitions[starts[v]] = { none, v };
+			counts[v] = starts[v] + 1;
+		}
+		for (SizeType r = 0; r < regions.size(); r += 1) {
+			Region & region = regions[r];
+			region.from = starts[region.first];
+			region.size = starts[region.first + region.count] - region.from;
+			for (SizeType b : region.order) {
+				for (SizeType i = blocks[b].begin; i < blocks[b].end; i += 1) {
+					const Access access = Graph::access(codes[i]);
+					if (!access.writes) continue;
+					const SizeType v = variable(r, access.write);
+					sites[i] = counts[v];
+					definitions[counts[v]] = { i, v };
+					counts[v] += 1;
+				}
+			}
+		}
+	}
+
+	void Graph::live() {
+		collect();
+		const Array<ByteCode> & codes = program -> instructions;
+		liveIn = Array<Bits>(blocks.size());
+		liveOut = Array<Bits>(blocks.size());
+		Array<Bits> uses(blocks.size()), kills(blocks.size());
+		for (SizeType r = 0; r < regions.size(); r += 1) {
+			const Region & region = regions[r];
+			const Bits empty(region.first, region.count);
+			Bits globals = empty, every = empty;
+			for (SizeType v = region.first; v < region.first + region.count; v += 1) {
+				if (!variables[v].frame) globals.set(v);
+				every.set(v);
+			}
+			for (SizeType b : region.order) {
+				Bits & use = uses[b], & kill = kills[b];
+				use = kill = liveIn[b] = liveOut[b] = empty;
+				for (SizeType i = blocks[b].begin; i < blocks[b].end; i += 1) {
+					const Access access = Graph::access(codes[i]);
+					for (SizeType k = 0; k < access.reads; k += 1) {
+						const SizeType v = variable(r, access.read[k]);
+						if (!kill.has(v)) use.set(v);
+					}
+					// Calls and returns read every global and
+					// swaps read every variable:
+					const Boolean swaps = codes[i].code == OPCode::SWP;
+					if (swaps || opaque(codes[i].code)) {
+						const Bits & read = swaps ? every : globals;
+						for (SizeType w = 0; w < use.words.size(); w += 1) {
+							use.words[w] |= read.words[w] & ~kill.words[w];
+						}
+					}
+					if (access.writes) kill.set(variable(r, access.write));
+				}
+			}
+			// Backwards, until nothing changes:
+			Boolean changed = true;
+			while (changed) {
+				changed = false;
+				for (SizeType k = region.order.size(); k > 0; k -= 1) {
+					const SizeType b = region.order[k - 1];
+					Bits & out = liveOut[b], & in = liveIn[b];
+					for (SizeType s : blocks[b].successors) out.merge(liveIn[s]);
+					for (SizeType w = 0; w < in.words.size(); w += 1) {
+						const UInt64 word = uses[b].words[w] |
+											(out.words[w] & ~kills[b].words[w]);
+						changed |= word != in.words[w];
+						in.words[w] = word;
+					}
+				}
+			}
+		}
+	}
+
+	void Graph::reach() {
+		collect();
+		const Array<ByteCode> & codes = program -> instructions;
+		reachIn = Array<Array<SizeType>>(blocks.size());
+		reachOut = Array<Array<SizeType>>(blocks.size());
+		Array<Array<SizeType>> gens(blocks.size());
+		// Variables written by a block, whose other
+		// definitions it kills:
+		Array<Array<SizeType>> written(blocks.size());
+		Array<SizeType> marks(variables.size(), none);
+		Array<SizeType> in, out;
+		for (SizeType r = 0; r < regions.size(); r += 1) {
+			const Region & region = regions[r];
+			for (SizeType b : region.order) {
+				// Last definition of every variable, calls
+				// may write every global and swaps every
+				// variable (their clobbers):
+				Array<SizeType> & gen = gens[b];
+				for (SizeType i = blocks[b].end; i > blocks[b].begin; i -= 1) {
+					const OPCode code = codes[i - 1].code;
+					const Boolean swaps = code == OPCode::SWP;
+					if (swaps || code == OPCode::CAL || code == OPCode::LAM) {
+						for (SizeType v = region.first; v < region.first + region.count; v += 1) {
+							if (marks[v] == b || (variables[v].frame && !swaps)) continue;
+							gen.push_back(starts[v]);
+						}
+					}
+					if (sites[i - 1] == none) continue;
+					const SizeType v = definitions[sites[i - 1]].variable;
+					if (marks[v] == b) continue;
+					marks[v] = b;
+					gen.push_back(sites[i - 1]);
+					written[b].push_back(v);
+				}
+				std::sort(gen.begin(), gen.end());
+				gen.erase(std::unique(gen.begin(), gen.end()), gen.end());
+			}
+			// Forwards, until nothing changes:
+			Boolean changed = true;
+			while (changed) {
+				changed = false;
+				for (SizeType b : region.order) {
+					in.clear();
+					for (SizeType p : blocks[b].predecessors) {
+						if (blocks[p].region != r) continue;
+						out.clear();
+						std::set_union(
+							in.begin(), in.end(),
+							reachOut[p].begin(), reachOut[p].end(),
+							std::back_inserter(out)
+						);
+						in.swap(out);
+					}
+					reachIn[b] = in;
+					for (SizeType v : written[b]) marks[v] = b;
+					in.erase(std::remove_if(in.begin(), in.end(), [&] (SizeType d) {
+						return marks[definitions[d].variable] == b;
+					}), in.end());
+					out.clear();
+					std::set_union(
+						in.begin(), in.end(),
+						gens[b].begin(), gens[b].end(),
+						std::back_inserter(out)
+					);
+					if (out == reachOut[b]) continue;
+					reachOut[b].swap(out);
+					changed = true;
+				}
+			}
+		}
+	}
+
+}
+
+#endif
@@ -0,0 +1,175 @@
+
+#include "../Common/Header.hpp"
+
+#ifndef SPIN_GRAPH_HPP
+#define SPIN_GRAPH_HPP
+
+#include "Program.hpp"
+
+namespace Spin {
+
+	// Control flow graph of a Program. Blocks end at
+	// every jump, call (CAL, LAM, TCL), RET and HLT, and
+	// start at their targets, at the return sites and
+	// at the routines of the Program. Every routine is
+	// a region of its own, reached from its entry
+	// without following calls, so that dominators,
+	// stack depths and the dataflow facts are computed
+	// a routine at a time and their sets only span the
+	// locals (or definitions) of that routine.
+
+	class Graph {
+
+		public:
+
+		static constexpr SizeType none = ~((SizeType) 0);
+		static constexpr Int64 unknown = INT64_MIN;
+
+		// Set of indices of a routine, from its base:
+		struct Bits {
+			SizeType base = 0;
+			Array<UInt64> words;
+			Bits() = default;
+			Bits(SizeType base, SizeType count):
+				base(base), words((count + 63) / 64) { }
+			inline Boolean has(SizeType i) const {
+				i -= base;
+				return (i >> 6) < words.size() &&
+					   ((words[i >> 6] >> (i & 63)) & 1);
+			}
+			inline void set(SizeType i) {
+				i -= base;
+				words[i >> 6] |= (UInt64) 1 << (i & 63);
+			}
+			inline void reset(SizeType i) {
+				i -= base;
+				words[i >> 6] &= ~((UInt64) 1 << (i & 63));
+			}
+			// Clears [from, to):
+			void reset(SizeType from, SizeType to);
+			// Returns whether it changed:
+			Boolean merge(const Bits & other);
+		};
+
+		struct Block {
+			// Instructions [begin, end):
+			SizeType begin = 0;
+			SizeType end = 0;
+			// Region, none when unreachable:
+			SizeType region = none;
+			// Immediate dominator (the entry has itself):
+			SizeType dominator = none;
+			// Depth of the stack at the entry, relative
+			// to the top of the frame of the routine:
+			Int64 depth = unknown;
+			Array<SizeType> successors;
+			Array<SizeType> predecessors;
+		};
+
+		struct Region {
+			SizeType entry = none;
+			// Blocks in reverse postorder:
+			Array<SizeType> order;
+			// Variables [first, first + count):
+			SizeType first = 0;
+			SizeType count = 0;
+			// Definitions [from, from + size):
+			SizeType from = 0;
+			SizeType size = 0;
+			// Stack effect of a call to the routine, the
+			// results minus the arguments (see measure):
+			Int64 result = unknown;
+		};
+
+		// Slot of the stack read or written by GET, SET,
+		// GLF, SLF and their superinstructions, either
+		// absolute (globals) or relative to the frame:
+		struct Variable {
+			SizeType region = none;
+			Boolean frame = false;
+			SizeType index = 0;
+		};
+
+		// A write of a variable. Each variable also has
+		// one definition without address standing for
+		// the calls (globals) and the swaps (every
+		// variable) of its routine, which may write it:
+		struct Definition {
+			SizeType address = none;
+			SizeType variable = none;
+		};
+
+		private:
+
+		Program * program = nullptr;
+
+		// Definitions of a variable [start, next start):
+		Array<SizeType> starts;
+
+		void partition();
+		void connect();
+		void order();
+
+		struct Access {
+			SizeType reads = 0;
+			UInt64 read[2] = { 0, 0 };
+			Boolean writes = false;
+			UInt64 write = 0;
+		};
+		static Access access(const ByteCode & byte);
+		static Boolean opaque(OPCode code);
+
+		SizeType variable(SizeType region, UInt64 slot) const;
+		// Definition made by every writing instruction:
+		Array<SizeType> sites;
+
+		Array<Dictionary<UInt64, SizeType>> slots;
+		void collect();
+
+		public:
+
+		Array<Block> blocks;
+		Array<Region> regions;
+		// Block of every instruction:
+		Array<SizeType> owners;
+
+		Array<Variable> variables;
+		Array<Definition> definitions;
+
+		// Indexed by block, filled by live() and reach()
+		// (definitions are sorted lists, as a long routine
+		// has far more of them than reach any block):
+		Array<Bits> liveIn, liveOut;
+		Array<Array<SizeType>> reachIn, reachOut;
+
+		Graph(Program * program);
+
+		// Stack effect of an instruction, unknown when
+		// it can't be told from the code alone (calls):
+		static Int64 effect(const Array<ByteCode> & codes, SizeType i);
+		// Same, with the results of the measured routines:
+		Int64 step(SizeType i) const;
+
+		// Immediate dominators of every reachable block:
+		void dominate();
+		Boolean dominates(SizeType a, SizeType b) const;
+
+		// Stack depths, false when two paths reaching
+		// the same block disagree or a block is left
+		// unknown (eg: after a lamda call, whose routine
+		// can't be told from the code):
+		Boolean measure();
+		Int64 depth(SizeType address) const;
+
+		// Variables live at the entry and at the exit of
+		// every block (calls and returns read every global):
+		void live();
+		// Definitions reaching the entry and the exit of
+		// every block:
+		void reach();
+
+	};
+
+}
+
+#endif
@@ -0,0 +1,215 @@
+
+/*!
+ *
+ *    + --------------------------------------- +
+ *    |  Optimiser.cpp                          |
+ *    |                                         |
+ *    |           Peephole Optimiser            |
+ *    |                                         |
+ *    |  Created by Cristian A.                 |
+ *    |  Copyright © MIT. All rights reserved.  |
+ *    + --------------------------------------- +
+ *
+ *    Note: This software is licensed under
+ *          the (MIT) Massachusetts Institute
+ *          of Technology License.
+ *
+!*/
+
+#include "Optimiser.hpp"
+
+#ifndef SPIN_OPTIMISER_CPP
+#define SPIN_OPTIMISER_CPP
+
+#include "Evaluator.hpp"
+
+namespace Spin {
+
+	// Keeps the source line of the replaced instruction:
+	static inline void replace(ByteCode & code, ByteCode with) {
+		with.line = code.line;
+		code = with;
+	}
+
+	const Array<Optimiser::Pattern> Optimiser::patterns = {
+		// Assignment statement and read of the same local:
+		// SET x, POP, GET x -> SET x
+		{ 3, [] (ByteCode * window) {
+			if (window[1].code != OPCode::POP) return false;
+			if (window[0].as.index != window[2].as.index) return false;
+			if (!(window[0].code == OPCode::SET && window[2].code == OPCode::GET) &&
+				!(window[0].code == OPCode::SLF && window[2].code == OPCode::GLF)) {
+				return false;
+			}
+			window[1].code = OPCode::TRM;
+			window[2].code = OPCode::TRM;
+			return true;
+		} },
+		// Operations on constants (eg: PSH, NEG -> PSH),
+		// left alone when they would crash:
+		{ 2, [] (ByteCode * window) {
+			if (Evaluator::arity(window[1]) != 1) return false;
+			Value operand, result;
+			if (!Evaluator::constant(window[0], operand)) return false;
+			if (!Evaluator::evaluate(window[1], & operand, result)) return false;
+			replace(window[0], { OPCode::PSH, { .value = result } });
+			window[1].code = OPCode::TRM;
+			return true;
+		} },
+		{ 3, [] (ByteCode * window) {
+			if (Evaluator::arity(window[2]) != 2) return false;
+			Value operands[2], result;
+			if (!Evaluator::constant(window[0], operands[0])) return false;
+			if (!Evaluator::constant(window[1], operands[1])) return false;
+			try {
+				if (!Evaluator::evaluate(window[2], operands, result)) return false;
+			} catch (Evaluator::Invalid & e) { return false; }
+			replace(window[0], { OPCode::PSH, { .value = result } });
+			window[1].code = OPCode::TRM;
+			window[2].code = OPCode::TRM;
+			return true;
+		} },
+		// Negated condition: NOT, JIF -> JIT
+		{ 2, [] (ByteCode * window) {
+			if (window[0].code != OPCode::NOT) return false;
+			switch (window[1].code) {
+				case OPCode::JIF:
+					replace(window[0], { OPCode::JIT, { .index = window[1].as.index } });
+				break;
+				case OPCode::JIT:
+					replace(window[0], { OPCode::JIF, { .index = window[1].as.index } });
+				break;
+				default: return false;
+			}
+			window[1].code = OPCode::TRM;
+			return true;
+		} },
+		// Values pushed only to be popped:
+		{ 2, [] (ByteCode * window) {
+			if (window[1].code != OPCode::POP) return false;
+			switch (window[0].code) {
+				case OPCode::PSH: case OPCode::STR:
+				case OPCode::TYP: case OPCode::GET:
+				case OPCode::GLF: case OPCode::PST:
+				case OPCode::PSF: case OPCode::PSI:
+				case OPCode::PSU: case OPCode::DHD: break;
+				default: return false;
+			}
+			window[0].code = OPCode::TRM;
+			window[1].code = OPCode::TRM;
+			return true;
+		} },
+	};
+
+	void Optimiser::thread(Program * program) {
+		// Jumps to a jump go straight to its target (at
+		// most as many hops as instructions, for loops
+		// like JMP 0, JMP 0) and jumps to the next
+		// instruction are removed:
+		Array<ByteCode> & codes = program -> instructions;
+		const SizeType size = codes.size();
+		for (SizeType i = 0; i < size; i += 1) {
+			switch (codes[i].code) {
+				case OPCode::JMP: case OPCode::JIF:
+				case OPCode::JAF: case OPCode::JIT:
+				case OPCode::JAT: break;
+				default: continue;
+			}
+			SizeType target = codes[i].as.index;
+			for (SizeType hops = 0; hops < size; hops += 1) {
+				if (target >= size || target == i) break;
+				if (codes[target].code != OPCode::JMP) break;
+				if (codes[target].as.index == target) break;
+				target = codes[target].as.index;
+			}
+			codes[i].as.index = target;
+			if (codes[i].code == OPCode::JMP && target == i + 1) {
+				codes[i].code = OPCode::TRM;
+			}
+		}
+	}
+
+	Boolean Optimiser::addressed(OPCode code) {
+		switch (code) {
+			case OPCode::JMP: case OPCode::JIF:
+			case OPCode::JAF: case OPCode::JIT:
+			case OPCode::JAT: case OPCode::JEQ:
+			case OPCode::JNE: case OPCode::JGR:
+			case OPCode::JLS: case OPCode::JGE:
+			case OPCode::JLE: case OPCode::CAL:
+			case OPCode::TCL: case OPCode::TLT:
+				return true;
+			default: return false;
+		}
+	}
+
+	Array<Boolean> Optimiser::targets(Program * program) {
+		const SizeType size = program -> instructions.size();
+		Array<Boolean> targets(size + 1, false);
+		for (ByteCode & byte : program -> instructions) {
+			if (!addressed(byte.code)) continue;
+			if (byte.as.index <= size) targets[byte.as.index] = true;
+		}
+		return targets;
+	}
+
+	void Optimiser::compact(Program * program) {
+		// Instructions marked for removal are deleted and
+		// every address is moved to the new position of
+		// its instruction (or of the next one):
+		Array<ByteCode> & codes = program -> instructions;
+		const SizeType size = codes.size();
+		Array<SizeType> moved(size + 1);
+		SizeType j = 0;
+		for (SizeType i = 0; i < size; i += 1) {
+			moved[i] = j;
+			if (codes[i].code != OPCode::TRM) j += 1;
+		}
+		moved[size] = j;
+		if (j == size) return;
+		j = 0;
+		for (SizeType i = 0; i < size; i += 1) {
+			ByteCode byte = codes[i];
+			if (byte.code == OPCode::TRM) continue;
+			if (addressed(byte.code) && byte.as.index <= size) {
+				byte.as.index = moved[byte.as.index];
+			}
+			codes[j] = byte;
+			j += 1;
+		}
+		codes.resize(j);
+		for (Program::Routine & routine : program -> routines) {
+			routine.address = moved[routine.address];
+		}
+	}
+
+	SizeType Optimiser::optimise(Program * program) {
+		// Every rewrite removes instructions, so the passes
+		// stop as soon as one removes nothing:
+		Array<ByteCode> & codes = program -> instructions;
+		const SizeType initial = codes.size();
+		SizeType size = 0;
+		while (size != codes.size()) {
+			size = codes.size();
+			thread(program);
+			const Array<Boolean> jumps = targets(program);
+			for (SizeType i = 0; i < size; i += 1) {
+				for (const Pattern & pattern : patterns) {
+					if (i + pattern.length > size) continue;
+					Boolean fits = true;
+					for (SizeType j = 0; j < pattern.length && fits; j += 1) {
+						// Only the first can be a jump target:
+						if (j > 0 && jumps[i + j]) fits = false;
+						if (codes[i + j].code == OPCode::TRM) fits = false;
+					}
+					if (fits && pattern.rewrite(codes.data() + i)) break;
+				}
+			}
+			compact(program);
+		}
+		return initial - codes.size();
+	}
+
+}
+
+#endif
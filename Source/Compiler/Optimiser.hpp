@@ -0,0 +1,52 @@
+
+#include "../Common/Header.hpp"
+
+#ifndef SPIN_OPTIMISER_HPP
+#define SPIN_OPTIMISER_HPP
+
+#include "Program.hpp"
+
+namespace Spin {
+
+	// Peephole optimiser of the compiler, run once the
+	// jumps and the calls have absolute addresses: it
+	// threads jumps to jumps and rewrites the windows
+	// of the pattern table until nothing changes. The
+	// removed instructions are compacted away and every
+	// address (jumps, calls, lamdas, routines) follows
+	// its instruction.
+
+	class Optimiser {
+
+		private:
+
+		// Rewrites a window of instructions, marking the
+		// removed ones with TRM, or returns false:
+		struct Pattern {
+			SizeType length;
+			Boolean (* rewrite)(ByteCode * window);
+		};
+
+		static const Array<Pattern> patterns;
+
+		static void thread(Program * program);
+
+		public:
+
+		Optimiser() = delete;
+
+		// Instructions whose index is an address:
+		static Boolean addressed(OPCode code);
+		// Instructions that are the target of an address:
+		static Array<Boolean> targets(Program * program);
+		// Deletes the instructions marked with TRM:
+		static void compact(Program * program);
+
+		// Returns the number of removed instructions:
+		static SizeType optimise(Program * program);
+
+	};
+
+}
+
+#endif
@@ -21,8 +21,11 @@
 #ifndef SPIN_PROGRAM_CPP
 #define SPIN_PROGRAM_CPP
 
+#include <algorithm>
+
 #include "../Utility/Serialiser.hpp"
 #include "../Manager/Manager.hpp"
+#include "Verifier.hpp"
 
 namespace Spin {
 
@@ -94,7 +97,15 @@ namespace Spin {
 				case OPCode::JIT: case OPCode::JAT:
 				case OPCode::SGS: case OPCode::AGS:
 				case OPCode::SSS: case OPCode::ASS:
-				case OPCode::PSA:
+				case OPCode::PSA: case OPCode::JEQ:
+				case OPCode::JNE: case OPCode::JGR:
+				case OPCode::JLS: case OPCode::JGE:
+				case OPCode::JLE: case OPCode::SEP:
+				case OPCode::SFP: case OPCode::GTT:
+				case OPCode::GFT: case OPCode::GTC:
+				case OPCode::GFC: case OPCode::ADG:
+				case OPCode::ADF: case OPCode::ICG:
+				case OPCode::ICF: case OPCode::TCL:
 					// 8 Bytes arguments:
 					Serialiser::write<UInt64>(buffer, byte.as.index);
 				break;
@@ -119,6 +130,31 @@ namespace Spin {
 				default: break;
 			}
 		}
+		// Debug section (files, routines and lines run
+		// length encoded), closed by a zero:
+		if (!debug.empty()) {
+			buffer -> insert(buffer -> end(), debug.begin(), debug.end());
+		} else if (!files.empty() || !routines.empty()) {
+			Serialiser::write<UInt64>(buffer, files.size());
+			for (String file : files) {
+				Serialiser::write<String>(buffer, file);
+			}
+			Serialiser::write<UInt64>(buffer, routines.size());
+			for (const Routine & routine : routines) {
+				Serialiser::write<String>(buffer, routine.name);
+				Serialiser::write<UInt64>(buffer, routine.address);
+				Serialiser::write<UInt32>(buffer, routine.line);
+			}
+			Serialiser::write<UInt64>(buffer, lines.size());
+			for (SizeType i = 0; i < lines.size(); i += 1) {
+				const SizeType end = i + 1 < lines.size() ?
+					lines[i + 1].address : instructions.size();
+				Serialiser::write<UInt32>(buffer, end - lines[i].address);
+				Serialiser::write<UInt32>(buffer, lines[i].file);
+				Serialiser::write<UInt32>(buffer, lines[i].line);
+			}
+			Serialiser::write<Byte>(buffer, 0);
+		}
 		try { Manager::writeBuffer(path, buffer); }
 		catch (Manager::BadFileException & b) {
 			delete buffer;
@@ -178,7 +214,15 @@ namespace Spin {
 				case OPCode::JIT: case OPCode::JAT:
 				case OPCode::SGS: case OPCode::AGS:
 				case OPCode::SSS: case OPCode::ASS:
-				case OPCode::PSA:
+				case OPCode::PSA: case OPCode::JEQ:
+				case OPCode::JNE: case OPCode::JGR:
+				case OPCode::JLS: case OPCode::JGE:
+				case OPCode::JLE: case OPCode::SEP:
+				case OPCode::SFP: case OPCode::GTT:
+				case OPCode::GFT: case OPCode::GTC:
+				case OPCode::GFC: case OPCode::ADG:
+				case OPCode::ADF: case OPCode::ICG:
+				case OPCode::ICF: case OPCode::TCL:
 					// 8 Bytes arguments:
 					try {
 						byte.as.index = Serialiser::read<UInt64>(buffer);
@@ -223,9 +267,81 @@ namespace Spin {
 			program -> instructions.push_back(byte);
 			size -= 1;
 		}
+		// Kept aside until it's needed:
+		const SizeType section = Serialiser::tell();
+		if (section < buffer -> size()) {
+			program -> debug.assign(buffer -> begin() + section, buffer -> end());
+		}
+		delete buffer;
+		// Malformed code never reaches the Processor:
+		try { Verifier::verify(program); }
+		catch (Verifier::Error & e) {
+			delete program;
+			throw;
+		}
 		return program;
 	}
 
+	// Last entry of a table starting before an address:
+	template <typename Entry>
+	static const Entry * search(const Array<Entry> & table, SizeType address) {
+		const auto found = std::upper_bound(
+			table.begin(), table.end(), address,
+			[] (SizeType address, const Entry & entry) {
+				return address < entry.address;
+			}
+		);
+		if (found == table.begin()) return nullptr;
+		return & * (found - 1);
+	}
+
+	void Program::expand() {
+		if (debug.empty()) return;
+		// The section is optional: when it can't be
+		// read the program just has no debug tables:
+		Serialiser::prepare();
+		try {
+			SizeType size = Serialiser::read<UInt64>(& debug);
+			for (SizeType i = 0; i < size; i += 1) {
+				files.push_back(Serialiser::read<String>(& debug));
+			}
+			size = Serialiser::read<UInt64>(& debug);
+			for (SizeType i = 0; i < size; i += 1) {
+				Routine routine;
+				routine.name = Serialiser::read<String>(& debug);
+				routine.address = Serialiser::read<UInt64>(& debug);
+				routine.line = Serialiser::read<UInt32>(& debug);
+				routines.push_back(routine);
+			}
+			size = Serialiser::read<UInt64>(& debug);
+			SizeType address = 0;
+			for (SizeType i = 0; i < size; i += 1) {
+				Line line;
+				line.address = address;
+				address += Serialiser::read<UInt32>(& debug);
+				line.file = Serialiser::read<UInt32>(& debug);
+				line.line = Serialiser::read<UInt32>(& debug);
+				lines.push_back(line);
+			}
+		} catch (Serialiser::ReadingError & e) {
+			files.clear();
+			routines.clear();
+			lines.clear();
+		}
+		debug.clear();
+		debug.shrink_to_fit();
+	}
+	const Program::Routine * Program::routine(SizeType address) {
+		expand();
+		return search(routines, address);
+	}
+	const Program::Line * Program::locate(SizeType address) {
+		expand();
+		const Line * line = search(lines, address);
+		if (!line || line -> file >= files.size()) return nullptr;
+		return line;
+	}
+
 	SourceCode::SourceCode(CodeUnit * main, Array<CodeUnit *> * wings, Array<String> * libraries) {
 		this -> main = main;
 		this -> wings = wings;
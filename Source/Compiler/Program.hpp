@@ -8,6 +8,7 @@
 
 #include <vector>
 #include <unordered_map>
+#include <cstdint>
 
 namespace Spin {
 
@@ -148,9 +149,56 @@ namespace Spin {
 
 		HLT, // halt
 
+		// Specialised:
+
+		ADI, // integer addition
+		SBI, // integer subtraction
+		MLI, // integer multiplication
+		DVI, // integer division
+		MDI, // integer modulus
+		ADR, // real addition
+		SBR, // real subtraction
+		MLR, // real multiplication
+		DVR, // real division
+
+		EQI, // integer equal
+		NEI, // integer not equal
+		GRI, // integer great
+		LSI, // integer less
+		GEI, // integer great equal
+		LEI, // integer less equal
+		EQR, // real equal
+		NER, // real not equal
+		GRR, // real great
+		LSR, // real less
+		GER, // real great equal
+		LER, // real less equal
+
+		JEQ, // integer jump if equal
+		JNE, // integer jump if not equal
+		JGR, // integer jump if great
+		JLS, // integer jump if less
+		JGE, // integer jump if great equal
+		JLE, // integer jump if less equal
+
+		// Superinstructions:
+
+		SEP, // set and pop
+		SFP, // set local from stack frame and pop
+		GTT, // get two locals
+		GFT, // get two locals from stack frame
+		GTC, // get local and push constant
+		GFC, // get local from stack frame and push constant
+		ADG, // integer addition of two locals
+		ADF, // integer addition of two locals from stack frame
+		ICG, // integer increment of local
+		ICF, // integer increment of local from stack frame
+		TCL, // tail call (reuses the frame of the caller)
+
 		// Temporary flags:
 
 		TLT, // temporary lamda tag
+		TRM, // temporary removal mark
 
 	};
 
@@ -165,15 +213,35 @@ namespace Spin {
 	};
 
 	struct ByteCode {
-		OPCode code = OPCode::RST;
-		union {
+		union Operand {
 			SizeType index;
 			Value value;
 			Type type;
 			Types types;
-		} as;
+		};
+		OPCode code = OPCode::RST;
+		// Source line, kept by the compiler to build
+		// the lines of the Program (in the padding):
+		std::uint32_t line = 0;
+		Operand as;
+		ByteCode() = default;
+		ByteCode(OPCode code, Operand as = { }):
+			code(code), as(as) { }
 	};
 
+	// Superinstructions that need two operands keep
+	// them both in the index, the first in the high
+	// half and the second in the low half:
+	constexpr SizeType pack(UInt32 a, UInt32 b) {
+		return ((SizeType) a << 32) | b;
+	}
+	constexpr UInt32 high(SizeType index) {
+		return (UInt32)(index >> 32);
+	}
+	constexpr UInt32 low(SizeType index) {
+		return (UInt32)(index & 0xFFFFFFFF);
+	}
+
 	class Program {
 		public:
 		class Error : Exception {
@@ -194,9 +262,45 @@ namespace Spin {
 			ErrorCode getErrorValue() const;
 			String getErrorCode() const;
 		};
+		// First instruction of a routine, the main
+		// code being the first one:
+		struct Routine {
+			String name;
+			SizeType address = 0;
+			UInt32 line = 0;
+		};
+		// First instruction of a run on the same line:
+		struct Line {
+			SizeType address = 0;
+			UInt32 file = 0;
+			UInt32 line = 0;
+		};
+		private:
+		// Debug section of a binary, decoded only
+		// when the tables are needed (see expand):
+		Buffer debug;
+		public:
 		Program() = default;
 		Array<ByteCode> instructions;
 		Array<String> strings;
+		// Compiled, or loaded and verified, code runs
+		// without checking its operands (see Verifier):
+		Boolean verified = false;
+		// Deepest stack of main and one call:
+		SizeType depth = 0;
+		// Deepest frame of every routine reached by
+		// calls, by its first instruction (see Verifier):
+		Dictionary<SizeType, SizeType> frames;
+		// Debug tables, sorted by address:
+		Array<String> files;
+		Array<Routine> routines;
+		Array<Line> lines;
+		// Decodes the debug section, if still pending:
+		void expand();
+		// Routine holding an address (or nullptr):
+		const Routine * routine(SizeType address);
+		// Source of an address (or nullptr):
+		const Line * locate(SizeType address);
 		void serialise(String path) const;
 		static Program * from(String path);
 	};
@@ -0,0 +1,196 @@
+
+/*!
+ *
+ *    + --------------------------------------- +
+ *    |  Verifier.cpp                           |
+ *    |                                         |
+ *    |            Bytecode Verifier            |
+ *    |                                         |
+ *    |  Created by Cristian A.                 |
+ *    |  Copyright © MIT. All rights reserved.  |
+ *    + --------------------------------------- +
+ *
+ *    Note: This software is licensed under
+ *          the (MIT) Massachusetts Institute
+ *          of Technology License.
+ *
+!*/
+
+#include "Verifier.hpp"
+
+#ifndef SPIN_VERIFIER_CPP
+#define SPIN_VERIFIER_CPP
+
+#include "Graph.hpp"
+
+namespace Spin {
+
+	Verifier::Error::Error(SizeType a, String m) {
+		address = a; message = m;
+	}
+	SizeType Verifier::Error::getAddress() const {
+		return address;
+	}
+	String Verifier::Error::getMessage() const {
+		return message;
+	}
+
+	// Checks the operands that don't depend on the
+	// depth of the stack:
+	static void operands(Program * program) {
+		const Array<ByteCode> & codes = program -> instructions;
+		const SizeType size = codes.size();
+		for (SizeType i = 0; i < size; i += 1) {
+			const ByteCode & byte = codes[i];
+			if (byte.code >= OPCode::TLT) {
+				throw Verifier::Error(i, "Unknown instruction!");
+			}
+			switch (byte.code) {
+				// Jumps to the end close the program:
+				case OPCode::JMP: case OPCode::JIF:
+				case OPCode::JAF: case OPCode::JIT:
+				case OPCode::JAT: case OPCode::JEQ:
+				case OPCode::JNE: case OPCode::JGR:
+				case OPCode::JLS: case OPCode::JGE:
+				case OPCode::JLE:
+					if (byte.as.index > size) {
+						throw Verifier::Error(i, "Jump out of the code!");
+					}
+				break;
+				case OPCode::CAL: case OPCode::TCL:
+					if (byte.as.index >= size) {
+						throw Verifier::Error(i, "Call out of the code!");
+					}
+				break;
+				case OPCode::STR:
+					if (byte.as.index >= program -> strings.size()) {
+						throw Verifier::Error(i, "String out of the table!");
+					}
+				break;
+				default: break;
+			}
+		}
+	}
+
+	// Checks the slots read or written by an instruction,
+	// with the globals below globals and the frame of its
+	// routine holding depth values:
+	static void slots(const ByteCode & byte, SizeType i,
+					  Int64 globals, Int64 depth) {
+		Int64 first = -1, second = -1;
+		Boolean frame = false;
+		switch (byte.code) {
+			case OPCode::GET: case OPCode::SET: case OPCode::SEP:
+				first = byte.as.index;
+			break;
+			case OPCode::GLF: case OPCode::SLF: case OPCode::SFP:
+				first = byte.as.index; frame = true;
+			break;
+			case OPCode::GTC: case OPCode::ICG:
+				first = high(byte.as.index);
+			break;
+			case OPCode::GFC: case OPCode::ICF:
+				first = high(byte.as.index); frame = true;
+			break;
+			case OPCode::GTT: case OPCode::ADG:
+				first = high(byte.as.index); second = low(byte.as.index);
+			break;
+			case OPCode::GFT: case OPCode::ADF:
+				first = high(byte.as.index); second = low(byte.as.index);
+				frame = true;
+			break;
+			case OPCode::SSF: case OPCode::DSK: case OPCode::PSA:
+				if ((UInt64) byte.as.index > (UInt64) depth) {
+					throw Verifier::Error(i, "Stack underflow!");
+				}
+			return;
+			default: return;
+		}
+		const Int64 bound = frame ? depth : globals;
+		// The second slot of a pair may be the first one
+		// just pushed (eg: GTT x, y with y on the top):
+		Int64 next = bound;
+		if (byte.code == OPCode::GTT || byte.code == OPCode::GFT) next += 1;
+		if (byte.as.index > (UInt64) INT64_MAX || first >= bound || second >= next) {
+			throw Verifier::Error(i, "Variable out of the stack!");
+		}
+	}
+
+	void Verifier::verify(Program * program) {
+		operands(program);
+		const Array<ByteCode> & codes = program -> instructions;
+		const SizeType size = codes.size();
+		if (size == 0) {
+			program -> verified = true;
+			return;
+		}
+		Graph graph(program);
+		// Unknown depths (after a lamda call) leave the
+		// Program unverified but still checked:
+		Boolean sound = graph.measure();
+		// Arguments of every routine, set by the SSF
+		// before each of its calls (main has none):
+		Array<SizeType> arities(graph.regions.size(), Graph::none);
+		arities[0] = 0;
+		for (SizeType i = 0; i < size; i += 1) {
+			if (codes[i].code != OPCode::CAL && codes[i].code != OPCode::TCL) continue;
+			const SizeType r = graph.blocks[graph.owners[codes[i].as.index]].region;
+			if (i == 0 || codes[i - 1].code != OPCode::SSF) { sound = false; continue; }
+			const SizeType arity = codes[i - 1].as.index;
+			if (arities[r] == Graph::none) arities[r] = arity;
+			else if (arities[r] != arity) sound = false;
+		}
+		// Deepest frame of every routine, main first so
+		// that its depth bounds the globals of the others:
+		Array<SizeType> depths(graph.regions.size(), 0);
+		for (SizeType r = 0; r < graph.regions.size(); r += 1) {
+			const Graph::Region & region = graph.regions[r];
+			// Without calls it's only reached by lamdas:
+			if (arities[r] == Graph::none) continue;
+			const Int64 arity = arities[r];
+			Int64 deepest = arity;
+			for (SizeType b : region.order) {
+				const Graph::Block & block = graph.blocks[b];
+				if (block.depth == Graph::unknown) continue;
+				Int64 depth = arity + block.depth;
+				for (SizeType i = block.begin; i < block.end; i += 1) {
+					slots(codes[i], i, r ? depths[0] : depth, depth);
+					if (codes[i].code == OPCode::RET && region.result != Graph::unknown &&
+						depth - arity != region.result) {
+						throw Error(i, "Inconsistent return depth!");
+					}
+					const Int64 effect = graph.step(i);
+					if (effect == Graph::unknown) { depth = Graph::unknown; break; }
+					depth += effect;
+					if (depth < 0) throw Error(i, "Stack underflow!");
+					if (depth > deepest) deepest = depth;
+				}
+				if (depth == Graph::unknown) continue;
+				for (SizeType s : block.successors) {
+					const Graph::Block & successor = graph.blocks[s];
+					if (successor.depth == Graph::unknown) continue;
+					if (arity + successor.depth != depth) {
+						throw Error(successor.begin, "Inconsistent stack depth!");
+					}
+				}
+			}
+			depths[r] = deepest;
+		}
+		// Without every depth they're only lower bounds:
+		program -> verified = sound;
+		SizeType deepest = 0;
+		for (SizeType r = 1; r < depths.size(); r += 1) {
+			if (depths[r] > deepest) deepest = depths[r];
+		}
+		program -> depth = depths[0] + deepest;
+		program -> frames.clear();
+		for (SizeType r = 0; r < depths.size(); r += 1) {
+			if (arities[r] == Graph::none) continue;
+			const SizeType entry = graph.blocks[graph.regions[r].entry].begin;
+			program -> frames[entry] = depths[r];
+		}
+	}
+
+}
+
+#endif
@@ -0,0 +1,46 @@
+
+#include "../Common/Header.hpp"
+
+#ifndef SPIN_VERIFIER_HPP
+#define SPIN_VERIFIER_HPP
+
+#include "Program.hpp"
+
+namespace Spin {
+
+	// Verifier of the binaries, run once when they are
+	// loaded: every opcode, jump, call and string has
+	// to be in range, the depth of the stack has to
+	// agree where paths merge, and every variable and
+	// frame has to lie within the stack of its routine.
+	// Malformed code is rejected. Code whose depths
+	// can't be told (lamda calls) runs with checked
+	// operands, every other verified Program runs
+	// without them (see Processor::evaluate).
+
+	class Verifier {
+
+		public:
+
+		class Error: Exception {
+			private:
+			SizeType address = 0;
+			String message;
+			public:
+			Error(SizeType a, String m);
+			SizeType getAddress() const;
+			String getMessage() const;
+		};
+
+		Verifier() = delete;
+
+		// Fills in the depths of the Program, marking it
+		// as verified when they are all known, or throws
+		// an Error:
+		static void verify(Program * program);
+
+	};
+
+}
+
+#endif
@@ -22,10 +22,18 @@
 #include "Preprocessor/Wings.hpp"
 #include "Compiler/Compiler.hpp"
 #include "Compiler/Decompiler.hpp"
+#include "Compiler/Verifier.hpp"
 #include "Virtual/Processor.hpp"
+#include "Virtual/Translator.hpp"
+#include "Virtual/Batch.hpp"
+#include "Virtual/Counters.hpp"
+#include "Virtual/Profiler.hpp"
 #include "Utility/Serialiser.hpp"
 #include "Utility/Arguments.hpp"
 
+#include <sstream>
+#include <thread>
+
 #define VERSION                          \
 	"\n% Spin programming language %"    \
 	"\nCurrent version: 3.0.0 beta.\n\n"
@@ -50,18 +58,45 @@
 	"\nInput file has invalid extension!"    \
 	"\nType spin -h and I'll guide you through.\n\n"
 
+#define ERROR_05                                     \
+	"\n% Spin catastrophic event %"                  \
+	"\nThe heap threshold should be a number!"      \
+	"\nType spin -h and I'll guide you through.\n\n"
+
+#define ERROR_07                                       \
+	"\n% Spin catastrophic event %"                    \
+	"\nThis build doesn't count opcodes!"              \
+	"\nBuild spinCounters (-DSPIN_COUNT) to use them.\n\n"
+
+#define ERROR_06                                     \
+	"\n% Spin catastrophic event %"                  \
+	"\nThe number of workers should be a number!"   \
+	"\nType spin -h and I'll guide you through.\n\n"
+
+#define ERROR_08                                     \
+	"\n% Spin catastrophic event %"                  \
+	"\nThe inlining budget should be a number!"     \
+	"\nType spin -h and I'll guide you through.\n\n"
+
 using namespace Spin;
 using namespace CommandLine;
 
 void printBadFile(Manager::BadFileException & b);
 void printProgramError(Program::Error & e);
 void printReadingError(Serialiser::ReadingError & r, String path);
-void printProcessorCrash(Processor::Crash & c);
+void printVerifierError(Verifier::Error & e, String path);
+void printUnverifiedJit(String path);
+void printProcessorCrash(Processor::Crash & c, Program * program);
 
-Int32 processCode(String path, Boolean noAnsi, Compiler::Options options);
+Int32 processCode(String path, Boolean noAnsi,
+				  Compiler::Options options, Boolean registers,
+				  Boolean compiling, Boolean testing,
+				  Counters * counters, Profiler * profiler);
 Int32 compileCode(String source, String destination,
 				  Boolean noAnsi, Compiler::Options options);
 Int32 decompileCode(String source, Boolean noAnsi);
+Int32 graphCode(String source);
+Int32 batchCode(String manifest, SizeType workers, Boolean compiling);
 
 Int32 main(Int32 argc, Character * argv[]) {
 
@@ -77,10 +112,41 @@ Int32 main(Int32 argc, Character * argv[]) {
 				<< endLine << "         Compiles a file into a binary."
 				<< endLine << "    spin [-decompile, -d] <file.sexy>"
 				<< endLine << "         Decompiles a binary file."
+				<< endLine << "    spin [-graph, -a] <file.sexy>"
+				<< endLine << "         Writes the control flow graph"
+				<< endLine << "         of a binary file in DOT."
+				<< endLine << "    spin [-batch, -b] <manifest>"
+				<< endLine << "         Runs every job of a manifest, made"
+				<< endLine << "         of lines <file.sexy> [input] [output]"
+				<< endLine << "         where '-' stands for no input."
 				<< endLine << "    spin [-version, -v]"
 				<< endLine << "         Shows the version number."
 				<< endLine << "    .... [-noAnsi, -n]"
 				<< endLine << "         Disable ansi output."
+				<< endLine << "    .... [-registers, -r]"
+				<< endLine << "         Executes on the register machine."
+				<< endLine << "    .... [-jit, -j]"
+				<< endLine << "         Compiles hot code to native code."
+				<< endLine << "    .... [-jitTest, -t]"
+				<< endLine << "         Compares the output of the processor"
+				<< endLine << "         with the output of the native code."
+				<< endLine << "    .... [-heap, -m] <objects>"
+				<< endLine << "         Objects before the first collection."
+				<< endLine << "    .... [-heapLog, -g]"
+				<< endLine << "         Logs the garbage collections."
+				<< endLine << "    .... [-inlining, -i] <instructions>"
+				<< endLine << "         Largest routine copied in place"
+				<< endLine << "         of its calls (0 turns it off)."
+				<< endLine << "    .... [-workers, -w] <threads>"
+				<< endLine << "         Threads running a batch."
+				<< endLine << "    .... [-counters, -k] <file.json>"
+				<< endLine << "         Counts the executed opcodes and"
+				<< endLine << "         writes the report (spinCounters)."
+				<< endLine << "    .... [-cycles, -y]"
+				<< endLine << "         Also times every opcode."
+				<< endLine << "    .... [-profile, -p] <file.folded>"
+				<< endLine << "         Samples the running routines and"
+				<< endLine << "         writes their folded stacks."
 				<< endLine << "  <file>: should be the main file and"
 				<< endLine << "          it should end with '.spin' or"
 				<< endLine << "          '.sexy' if it's a binary file."
@@ -120,10 +186,24 @@ Int32 main(Int32 argc, Character * argv[]) {
 	Arguments::options = {
 		{   "-compile", "-c", 2 },
 		{ "-decompile", "-d", 1 },
+		{     "-graph", "-a", 1 },
 		{   "-version", "-v" },
 		{    "-noAnsi", "-n" },
 		{ "-noFolding", "-f" },
 		{   "-sectors", "-s" },
+		{  "-noFusing", "-u" },
+		{"-noPeephole", "-o" },
+		{  "-inlining", "-i", 1 },
+		{ "-registers", "-r" },
+		{       "-jit", "-j" },
+		{   "-jitTest", "-t" },
+		{      "-heap", "-m", 1 },
+		{   "-heapLog", "-g" },
+		{     "-batch", "-b", 1 },
+		{   "-workers", "-w", 1 },
+		{  "-counters", "-k", 1 },
+		{    "-cycles", "-y" },
+		{   "-profile", "-p", 1 },
 	};
 
 	Parameters parameters = Arguments::parse(argc, argv);
@@ -131,11 +211,61 @@ Int32 main(Int32 argc, Character * argv[]) {
 	if   (parameters.failed()) return ExitCodes::failure;
 
 	const Boolean noAnsi = parameters["-noAnsi"].to<Boolean>();
+	const Boolean registers = parameters["-registers"].to<Boolean>();
+	const Boolean compiling = parameters["-jit"].to<Boolean>();
+	const Boolean testing = parameters["-jitTest"].to<Boolean>();
 
 	Compiler::Options options = {
-		parameters["-noFolding"].to<Boolean>(),
-		parameters["-sectors"].to<Boolean>()
+		!parameters["-noFolding"].to<Boolean>(),
+		parameters["-sectors"].to<Boolean>(),
+		!parameters["-noFusing"].to<Boolean>(),
+		!parameters["-noPeephole"].to<Boolean>()
 	};
+	if (!parameters["-inlining"].object.empty()) {
+		try {
+			const Int64 budget = parameters["-inlining"].to<Int64>();
+			if (budget < 0) throw ConversionException();
+			options.inlining = (SizeType) budget;
+		} catch (ConversionException & e) {
+			OStream << ERROR_08;
+			return ExitCodes::failure;
+		}
+	}
+
+	Collector::Options & heap = Processor::self() -> heap;
+	heap.logging = parameters["-heapLog"].to<Boolean>();
+	if (!parameters["-heap"].object.empty()) {
+		try {
+			const Int64 threshold = parameters["-heap"].to<Int64>();
+			if (threshold <= 0) throw ConversionException();
+			heap.threshold = (SizeType) threshold;
+		} catch (ConversionException & e) {
+			OStream << ERROR_05;
+			return ExitCodes::failure;
+		}
+	}
+
+	SizeType workers = std::thread::hardware_concurrency();
+	if (!parameters["-workers"].object.empty()) {
+		try {
+			const Int64 threads = parameters["-workers"].to<Int64>();
+			if (threads <= 0) throw ConversionException();
+			workers = (SizeType) threads;
+		} catch (ConversionException & e) {
+			OStream << ERROR_06;
+			return ExitCodes::failure;
+		}
+	}
+
+	const String report = parameters["-counters"].object.empty() ?
+		String() : parameters["-counters"].to<String>();
+	const Boolean timing = parameters["-cycles"].to<Boolean>();
+	const String folded = parameters["-profile"].object.empty() ?
+		String() : parameters["-profile"].to<String>();
+	if (!report.empty() && !Processor::counted) {
+		OStream << ERROR_07;
+		return ExitCodes::failure;
+	}
 
 	if (parameters["-version"].to<Boolean>()) {
 		OStream << VERSION;
@@ -143,7 +273,10 @@ Int32 main(Int32 argc, Character * argv[]) {
 	}
 
 	parameters.removeOptionals({
-		"-version", "-noAnsi", "-noFolding", "-sectors"
+		"-version", "-noAnsi", "-noFolding", "-sectors",
+		"-noFusing", "-noPeephole", "-inlining", "-registers", "-jit",
+		"-jitTest", "-heap", "-heapLog", "-workers",
+		"-counters", "-cycles", "-profile"
 	});
 
 	if (parameters.size() == 0) {
@@ -160,15 +293,33 @@ Int32 main(Int32 argc, Character * argv[]) {
 				return ExitCodes::failure;
 			break;
 		}
-		return processCode(
+		Counters counters(timing);
+		Profiler profiler;
+		const Int32 code = processCode(
 			parameters.freeParameters.at(0),
-			noAnsi, options
+			noAnsi, options, registers,
+			compiling, testing,
+			report.empty() ? nullptr : & counters,
+			folded.empty() ? nullptr : & profiler
 		);
+		try {
+			if (!report.empty()) {
+				counters.print(EStream);
+				counters.report(report);
+			}
+			if (!folded.empty()) profiler.write(folded);
+		} catch (Manager::BadFileException & b) {
+			printBadFile(b);
+			return ExitCodes::failure;
+		}
+		return code;
 	} else {
 		// Its either `spin -compile file.spin file.sexy`
 		//         or `spin -decompile file.sexy`
+		//         or `spin -graph file.sexy`
+		//         or `spin -batch manifest`
 		String selected = parameters.mutualExclusion({
-			"-compile", "-decompile"
+			"-compile", "-decompile", "-graph", "-batch"
 		});
 		if (parameters.exclusionFailed()) {
 			return ExitCodes::failure;
@@ -195,6 +346,15 @@ Int32 main(Int32 argc, Character * argv[]) {
 					noAnsi
 				);
 			} break;
+			case 'g': {
+				return graphCode(parameters["-graph"].to<String>());
+			} break;
+			case 'b': {
+				return batchCode(
+					parameters["-batch"].to<String>(),
+					workers, compiling
+				);
+			} break;
 			case 'v':
 				OStream << VERSION;
 				return ExitCodes::success;
@@ -222,7 +382,20 @@ void printReadingError(Serialiser::ReadingError & r, String path) {
 			<< endLine << "Couldn't read invalid file ['"
 			<< path << "']!" << endLine << endLine;
 }
-void printProcessorCrash(Processor::Crash & c) {
+void printVerifierError(Verifier::Error & e, String path) {
+	OStream << endLine << "% VRF Error on address [0x"
+			<< hexadecimal << padding(8) << e.getAddress()
+			<< "] %" << decimal << endLine << e.getMessage()
+			<< endLine << "Rejected file ['" << path
+			<< "']." << endLine << endLine;
+}
+void printUnverifiedJit(String path) {
+	EStream << endLine << "% JIT Disabled %" << endLine
+			<< "The depths of ['" << path << "'] can't be verified,"
+			<< endLine << "it runs with checked operands and without"
+			<< " native code!" << endLine << endLine;
+}
+void printProcessorCrash(Processor::Crash & c, Program * program) {
 	OStream << endLine << "% EVL Error on address [0x"
 			<< hexadecimal << padding(8) << c.getAddress()
 			<< "] %" << endLine << "Crash bytecode: "
@@ -230,10 +403,19 @@ void printProcessorCrash(Processor::Crash & c) {
 			<< c.getInstruction().code << " "
 			<< hexadecimal << padding(16)
 			<< hexadecimal << c.getInstruction().as.index
-			<< endLine << endLine;
+			<< decimal << endLine;
+	const Program::Line * line = program -> locate(c.getAddress());
+	if (line) {
+		OStream << "Crashed on line " << line -> line << " of ['"
+				<< program -> files[line -> file] << "']." << endLine;
+	}
+	OStream << endLine;
 }
 
-Int32 processCode(String path, Boolean noAnsi, Compiler::Options options) {
+Int32 processCode(String path, Boolean noAnsi,
+				  Compiler::Options options, Boolean registers,
+				  Boolean compiling, Boolean testing,
+				  Counters * counters, Profiler * profiler) {
 	Program * program = nullptr;
 	if (path.ends_with(".spin")) {
 		Compiler * compiler = Compiler::self();
@@ -259,6 +441,9 @@ Int32 processCode(String path, Boolean noAnsi, Compiler::Options options) {
 		catch (Serialiser::ReadingError & r) {
 			printReadingError(r, path);
 			return ExitCodes::failure;
+		} catch (Verifier::Error & e) {
+			printVerifierError(e, path);
+			return ExitCodes::failure;
 		} catch (Manager::BadFileException & b) {
 			printBadFile(b);
 			return ExitCodes::failure;
@@ -267,13 +452,66 @@ Int32 processCode(String path, Boolean noAnsi, Compiler::Options options) {
 		OStream << ERROR_04;
 		return ExitCodes::failure;
 	}
-	Processor * processor = Processor::self();
-	try { processor -> run(program); }
-	catch (Processor::Crash & c) {
-		printProcessorCrash(c);
+	// See Processor::run:
+	if ((compiling || testing) && !program -> verified) {
+		printUnverifiedJit(path);
+	}
+	if (testing) {
+		// Runs twice, the second time compiling every
+		// entry as soon as it's reached, and compares
+		// the outputs (crashes included):
+		const auto execute = [program] (Boolean compiling) {
+			std::stringstream output;
+			auto buffer = OStream.rdbuf(output.rdbuf());
+			auto flags = OStream.flags();
+			try { Processor::self() -> run(program, compiling, 0); }
+			catch (Processor::Crash & c) { printProcessorCrash(c, program); }
+			OStream.rdbuf(buffer);
+			OStream.flags(flags);
+			return output.str();
+		};
+		if (!Jit::supported) {
+			OStream << endLine << "% JIT Unavailable %" << endLine
+					<< "Native code isn't supported on this target!"
+					<< endLine << endLine;
+			delete program;
+			return ExitCodes::failure;
+		}
+		const String expected = execute(false);
+		const String obtained = execute(true);
+		delete program;
+		if (expected == obtained) {
+			OStream << expected << endLine << "% JIT Test Passed %"
+					<< endLine << "The outputs are identical."
+					<< endLine << endLine;
+			return ExitCodes::success;
+		}
+		OStream << endLine << "% JIT Test Failed %" << endLine
+				<< "Processor:" << endLine << expected << endLine
+				<< "Native code:" << endLine << obtained
+				<< endLine << endLine;
+		return ExitCodes::failure;
+	}
+	// Programs the register machine can't handle
+	// still run on the stack processor:
+	Machine::Code * code = nullptr;
+	if (registers) code = Translator::translate(program);
+	// Set only for the run:
+	Processor::self() -> counters = counters;
+	Processor::self() -> profiler = profiler;
+	if (profiler) profiler -> start();
+	try {
+		if (code) Machine::self() -> run(code);
+		else Processor::self() -> run(program, compiling);
+	} catch (Processor::Crash & c) {
+		if (profiler) profiler -> stop();
+		printProcessorCrash(c, program);
+		if (code) delete code;
 		if (program) delete program;
 		return ExitCodes::failure;
 	}
+	if (profiler) profiler -> stop();
+	if (code) delete code;
 	delete program;
 	return ExitCodes::success;
 }
@@ -292,6 +530,16 @@ Int32 compileCode(String source, String destination,
 		program = compiler -> compile(code);
 		delete code; code = nullptr;
 		program -> serialise(destination);
+		// Reported aside, so that a compilation stays
+		// silent on the standard output:
+		if (options.inlining) {
+			EStream << "Inlining: " << compiler -> inlined
+					<< " calls inlined." << endLine;
+		}
+		if (options.peephole) {
+			EStream << "Peephole: " << compiler -> removed
+					<< " instructions removed." << endLine;
+		}
 	} catch (Program::Error & e) {
 		printProgramError(e);
 		if (code) delete code;
@@ -318,14 +566,151 @@ Int32 decompileCode(String source, Boolean noAnsi) {
 	} catch (Serialiser::ReadingError & r) {
 		printReadingError(r, source);
 		return ExitCodes::failure;
+	} catch (Verifier::Error & e) {
+		printVerifierError(e, source);
+		return ExitCodes::failure;
 	}
 	Decompiler::decompile(program, noAnsi);
 	delete program;
 	return ExitCodes::success;
 }
+Int32 graphCode(String source) {
+	if (!source.ends_with(".sexy")) {
+		OStream << ERROR_04;
+		return ExitCodes::failure;
+	}
+	Program * program = nullptr;
+	try { program = Program::from(source); }
+	catch (Manager::BadFileException & b) {
+		printBadFile(b);
+		return ExitCodes::failure;
+	} catch (Serialiser::ReadingError & r) {
+		printReadingError(r, source);
+		return ExitCodes::failure;
+	} catch (Verifier::Error & e) {
+		printVerifierError(e, source);
+		return ExitCodes::failure;
+	}
+	Decompiler::graph(program);
+	delete program;
+	return ExitCodes::success;
+}
+
+Int32 batchCode(String manifest, SizeType workers, Boolean compiling) {
+	struct Entry {
+		String program;
+		String input;
+		String output;
+	};
+	Array<Entry> entries;
+	String * contents = nullptr;
+	try { contents = Manager::stringFromFile(manifest); }
+	catch (Manager::BadFileException & b) {
+		printBadFile(b);
+		return ExitCodes::failure;
+	}
+	std::istringstream lines(* contents);
+	delete contents;
+	String line;
+	while (std::getline(lines, line)) {
+		std::istringstream columns(line);
+		Entry entry;
+		if (!(columns >> entry.program)) continue;
+		if (entry.program.starts_with("#")) continue;
+		columns >> entry.input >> entry.output;
+		if (entry.input == "-") entry.input.clear();
+		entries.push_back(entry);
+	}
+	// Every distinct program and input is read once:
+	Dictionary<String, Program *> programs;
+	Dictionary<String, String> inputs;
+	const auto release = [&programs] {
+		for (auto & program : programs) delete program.second;
+	};
+	Array<Batch::Job> jobs(entries.size());
+	for (SizeType i = 0; i < entries.size(); i += 1) {
+		const Entry & entry = entries[i];
+		if (!entry.program.ends_with(".sexy")) {
+			OStream << ERROR_04;
+			release();
+			return ExitCodes::failure;
+		}
+		try {
+			Program * & program = programs[entry.program];
+			if (!program) {
+				program = Program::from(entry.program);
+				if (compiling && !program -> verified) {
+					printUnverifiedJit(entry.program);
+				}
+			}
+			jobs[i].program = program;
+			if (entry.input.empty()) continue;
+			auto input = inputs.find(entry.input);
+			if (input == inputs.end()) {
+				String * text = Manager::stringFromFile(entry.input);
+				input = inputs.emplace(entry.input, * text).first;
+				delete text;
+			}
+			jobs[i].input = input -> second;
+		} catch (Serialiser::ReadingError & r) {
+			printReadingError(r, entry.program);
+			release();
+			return ExitCodes::failure;
+		} catch (Verifier::Error & e) {
+			printVerifierError(e, entry.program);
+			release();
+			return ExitCodes::failure;
+		} catch (Manager::BadFileException & b) {
+			printBadFile(b);
+			release();
+			return ExitCodes::failure;
+		}
+	}
+	const Batch::Report report = Batch::run(
+		jobs, workers, Processor::self() -> heap, compiling
+	);
+	// Outputs without a file are shown in the order
+	// of the manifest, crashes included:
+	for (SizeType i = 0; i < jobs.size(); i += 1) {
+		std::stringstream output;
+		auto buffer = OStream.rdbuf(output.rdbuf());
+		auto flags = OStream.flags();
+		OStream << jobs[i].output;
+		if (jobs[i].crashed) {
+			Processor::Crash crash(jobs[i].address, jobs[i].instruction);
+			printProcessorCrash(crash, jobs[i].program);
+		}
+		OStream.rdbuf(buffer);
+		OStream.flags(flags);
+		if (entries[i].output.empty()) {
+			OStream << endLine << "% Job " << i + 1 << " ['"
+					<< entries[i].program << "'] %" << endLine
+					<< output.str() << endLine;
+			continue;
+		}
+		try { Manager::createNewFile(entries[i].output, output.str()); }
+		catch (Manager::BadFileException & b) { printBadFile(b); }
+	}
+	release();
+	OStream << endLine << "% Batch Report %" << endLine
+			<< "Jobs: " << report.jobs << " (" << report.crashes
+			<< " crashed) of " << programs.size() << " programs on "
+			<< report.workers << " workers." << endLine
+			<< std::fixed << std::setprecision(3)
+			<< "Time: " << report.milliseconds << "ms, "
+			<< report.throughput << " jobs per second." << endLine
+			<< "Latency: p50 " << report.median << "ms, p90 "
+			<< report.p90 << "ms, p99 " << report.p99 << "ms, max "
+			<< report.maximum << "ms." << endLine << endLine;
+	return report.crashes ? ExitCodes::failure : ExitCodes::success;
+}
 
 #undef VERSION
 #undef ERROR_01
 #undef ERROR_02
 #undef ERROR_03
 #undef ERROR_04
+#undef ERROR_05
+#undef ERROR_06
+#undef ERROR_07
+#undef ERROR_08
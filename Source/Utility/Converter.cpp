@@ -266,7 +266,7 @@ namespace Spin {
 		// absolute value with a leading '-'.
 		// Use an array large enough for the
 		// maximum number of digits + 1.
-		static Character buffer[20];
+		Character buffer[20];
 		SizeType size = 20;
 		Boolean negative = false;
 		if (i < 0) {
@@ -0,0 +1,188 @@
+
+#include "../Common/Header.hpp"
+
+#ifndef SPIN_GUARDED_PURE
+#define SPIN_GUARDED_PURE
+
+#include <cstdlib>
+#include <new>
+
+// Guard pages need virtual memory (mmap, mprotect),
+// every other target grows the stack like Stack:
+
+#if defined(__unix__) || defined(__APPLE__)
+	#define SPIN_GUARDED
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+namespace Spin {
+
+	// Stack of the Processor: the whole range is
+	// reserved up front and the system commits its
+	// pages at their first use. A page without access
+	// closes both ends, so a push over the top (or a
+	// pop under the bottom) faults instead of being
+	// checked, and the addresses of the nodes never
+	// change. The Processor turns the fault into a
+	// crash (see guards).
+
+	template <typename Type>
+	class Guarded {
+
+		private:
+
+		Type * stack = nullptr;
+
+		SizeType count = 0;
+		SizeType maxCount = 16;
+
+		#ifdef SPIN_GUARDED
+		UInt8 * mapping = nullptr;
+		SizeType mapped = 0;
+		SizeType page = 0;
+		#else
+		SizeType limit = 0;
+		void increase();
+		#endif
+
+		public:
+
+		// Nodes reserved, halved while the system
+		// refuses the range (eg: limited address space):
+		Guarded(SizeType reserve);
+		~Guarded();
+
+		Guarded(const Guarded &) = delete;
+		Guarded & operator = (const Guarded &) = delete;
+
+		inline Type at(SizeType index) { return stack[index]; }
+		inline void edit(SizeType index, Type node) { stack[index] = node; }
+
+		inline void push(Type node) {
+			#ifndef SPIN_GUARDED
+			if (count == maxCount) increase();
+			#endif
+			stack[count] = node;
+			count += 1;
+		}
+
+		inline Type top() { return stack[count - 1]; }
+		// Top, edited in place:
+		inline Type & peek() { return stack[count - 1]; }
+		inline Type pop() { return stack[--count]; }
+
+		inline void decrease() { count -= 1; }
+		inline void decrease(SizeType number) { count -= number; }
+
+		inline Boolean isEmpty() { return count == 0; }
+		inline SizeType size() { return count; }
+
+		// Raw access for native code:
+		inline Type * data() { return stack; }
+		inline SizeType capacity() { return maxCount; }
+		inline void resize(SizeType number) { count = number; }
+
+		inline void clear() { count = 0; }
+
+		// Commits the room of the first nodes up front:
+		void reserve(SizeType number);
+
+		// Whether an address falls in a guard page:
+		Boolean guards(const void * address) const;
+
+	};
+
+	#ifdef SPIN_GUARDED
+
+	template <typename Type>
+	Guarded<Type>::Guarded(SizeType reserve) {
+		page = (SizeType) sysconf(_SC_PAGESIZE);
+		Int32 flags = MAP_PRIVATE | MAP_ANONYMOUS;
+		#ifdef MAP_NORESERVE
+		flags |= MAP_NORESERVE;
+		#endif
+		while (true) {
+			const SizeType bytes = (
+				(reserve * sizeof(Type) + page - 1) / page
+			) * page;
+			// A guard page on each side:
+			mapped = bytes + 2 * page;
+			void * memory = mmap(
+				nullptr, mapped, PROT_READ | PROT_WRITE, flags, - 1, 0
+			);
+			if (memory != MAP_FAILED) {
+				mapping = (UInt8 *) memory;
+				maxCount = bytes / sizeof(Type);
+				break;
+			}
+			if (reserve <= page) throw std::bad_alloc();
+			reserve /= 2;
+		}
+		mprotect(mapping, page, PROT_NONE);
+		mprotect(mapping + mapped - page, page, PROT_NONE);
+		stack = (Type *)(mapping + page);
+	}
+
+	template <typename Type>
+	Guarded<Type>::~Guarded() {
+		munmap(mapping, mapped);
+	}
+
+	template <typename Type>
+	void Guarded<Type>::reserve(SizeType number) {
+		if (number > maxCount) number = maxCount;
+		// A write on each page, so that the system
+		// doesn't fault them in while running:
+		volatile UInt8 * bytes = (volatile UInt8 *) stack;
+		for (SizeType i = 0; i < number * sizeof(Type); i += page) bytes[i] = 0;
+	}
+
+	template <typename Type>
+	Boolean Guarded<Type>::guards(const void * address) const {
+		const UInt8 * byte = (const UInt8 *) address;
+		return (byte >= mapping && byte < mapping + page) ||
+			   (byte >= mapping + mapped - page && byte < mapping + mapped);
+	}
+
+	#else
+
+	template <typename Type>
+	Guarded<Type>::Guarded(SizeType reserve): limit(reserve) {
+		stack = (Type *) std::malloc(maxCount * sizeof(Type));
+	}
+
+	template <typename Type>
+	Guarded<Type>::~Guarded() {
+		std::free(stack);
+	}
+
+	template <typename Type>
+	void Guarded<Type>::increase() {
+		if (maxCount >= limit) throw std::bad_alloc();
+		maxCount *= 1.5;
+		stack = (Type *) std::realloc(
+			stack, maxCount * sizeof(Type)
+		);
+	}
+
+	template <typename Type>
+	void Guarded<Type>::reserve(SizeType number) {
+		if (number <= maxCount) return;
+		if (number > limit) number = limit;
+		maxCount = number;
+		stack = (Type *) std::realloc(
+			stack, maxCount * sizeof(Type)
+		);
+	}
+
+	template <typename Type>
+	Boolean Guarded<Type>::guards(const void *) const {
+		return false;
+	}
+
+	#endif
+
+}
+
+#endif
@@ -0,0 +1,187 @@
+#include "../Common/Header.hpp"
+
+#ifndef SPIN_POOL_PURE
+#define SPIN_POOL_PURE
+
+#include <algorithm>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Spin {
+
+	// Size class of a single type: objects are carved
+	// out of fixed blocks by bumping the top of the
+	// current block, cells released by a collection
+	// are handed out again before bumping, and reset
+	// gives every block back at once (destroying the
+	// live objects only when the type needs it).
+
+	template <typename Type>
+	class Pool {
+
+		private:
+
+		// The object comes first, so that the address
+		// of a cell is the address of its object:
+		struct Cell {
+			alignas(Type) UInt8 object[sizeof(Type)];
+			Boolean used;
+			Boolean marked;
+		};
+
+		static constexpr SizeType cells = 1024;
+
+		struct Block {
+			SizeType top = 0;
+			Cell cells[Pool::cells];
+		};
+
+		// In allocation order and sorted by address:
+		Array<Block *> blocks;
+		Array<Block *> sorted;
+		SizeType current = 0;
+
+		Array<Cell *> available;
+		SizeType count = 0;
+
+		Cell * next();
+		Cell * find(Pointer pointer) const;
+
+		static inline Type * of(Cell * cell) {
+			return std::launder((Type *) cell -> object);
+		}
+
+		public:
+
+		Pool() = default;
+		~Pool();
+
+		Pool(const Pool &) = delete;
+		Pool & operator = (const Pool &) = delete;
+
+		template <typename ... Arguments>
+		inline Type * make(Arguments && ... arguments) {
+			Cell * cell = nullptr;
+			if (available.empty()) cell = next();
+			else {
+				cell = available.back();
+				available.pop_back();
+			}
+			Type * object = new (cell -> object) Type(
+				std::forward<Arguments>(arguments) ...
+			);
+			cell -> used = true;
+			cell -> marked = false;
+			count += 1;
+			return object;
+		}
+
+		// The object at the address, if it has just
+		// been marked (nullptr otherwise):
+		Type * mark(Pointer pointer);
+
+		// Releases the unmarked objects and returns
+		// how many they were:
+		SizeType sweep();
+
+		// Releases every object:
+		void reset();
+
+		SizeType size() const;
+
+	};
+
+	template <typename Type>
+	Pool<Type>::~Pool() {
+		reset();
+		for (Block * block : blocks) delete block;
+	}
+
+	template <typename Type>
+	typename Pool<Type>::Cell * Pool<Type>::next() {
+		while (current < blocks.size() &&
+			   blocks[current] -> top == cells) {
+			current += 1;
+		}
+		if (current == blocks.size()) {
+			Block * block = new Block();
+			blocks.push_back(block);
+			sorted.insert(std::upper_bound(
+				sorted.begin(), sorted.end(), block
+			), block);
+		}
+		Block * block = blocks[current];
+		Cell * cell = & block -> cells[block -> top];
+		block -> top += 1;
+		return cell;
+	}
+
+	template <typename Type>
+	typename Pool<Type>::Cell * Pool<Type>::find(Pointer pointer) const {
+		auto found = std::upper_bound(
+			sorted.begin(), sorted.end(), (Block *) pointer
+		);
+		if (found == sorted.begin()) return nullptr;
+		Block * block = * (found - 1);
+		const SizeType offset = (UInt8 *) pointer - (UInt8 *) block -> cells;
+		if (offset >= block -> top * sizeof(Cell)) return nullptr;
+		if (offset % sizeof(Cell)) return nullptr;
+		Cell * cell = & block -> cells[offset / sizeof(Cell)];
+		return cell -> used ? cell : nullptr;
+	}
+
+	template <typename Type>
+	Type * Pool<Type>::mark(Pointer pointer) {
+		if (sorted.empty()) return nullptr;
+		Cell * cell = find(pointer);
+		if (!cell || cell -> marked) return nullptr;
+		cell -> marked = true;
+		return of(cell);
+	}
+
+	template <typename Type>
+	SizeType Pool<Type>::sweep() {
+		SizeType freed = 0;
+		for (Block * block : blocks) {
+			for (SizeType i = 0; i < block -> top; i += 1) {
+				Cell & cell = block -> cells[i];
+				if (!cell.used) continue;
+				if (cell.marked) {
+					cell.marked = false;
+					continue;
+				}
+				of(& cell) -> ~Type();
+				cell.used = false;
+				available.push_back(& cell);
+				freed += 1;
+			}
+		}
+		count -= freed;
+		return freed;
+	}
+
+	template <typename Type>
+	void Pool<Type>::reset() {
+		for (Block * block : blocks) {
+			if constexpr (!std::is_trivially_destructible_v<Type>) {
+				for (SizeType i = 0; i < block -> top; i += 1) {
+					Cell & cell = block -> cells[i];
+					if (cell.used) of(& cell) -> ~Type();
+				}
+			}
+			block -> top = 0;
+		}
+		available.clear();
+		current = 0;
+		count = 0;
+	}
+
+	template <typename Type>
+	SizeType Pool<Type>::size() const {
+		return count;
+	}
+
+}
+
+#endif
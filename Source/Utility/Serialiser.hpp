@@ -19,6 +19,7 @@ namespace Spin {
 		class ReadingError: Exception { };
 
 		static inline void seek(SizeType i);
+		static inline SizeType tell();
 		static inline void prepare();
 
 		template <typename Type>
@@ -32,6 +33,9 @@ namespace Spin {
 	inline void Serialiser::seek(SizeType i) {
 		index = i;
 	}
+	inline SizeType Serialiser::tell() {
+		return index;
+	}
 	inline void Serialiser::prepare() {
 		index = 0;
 	}
@@ -37,6 +37,11 @@ namespace Spin {
 		Boolean isEmpty();
 		SizeType size();
 
+		// Raw access for native code:
+		Type * data();
+		SizeType capacity();
+		void resize(SizeType number);
+
 		void clear();
 
 	};
@@ -109,6 +114,21 @@ namespace Spin {
 		return count;
 	}
 
+	template <typename Type>
+	Type * Stack<Type>::data() {
+		return stack;
+	}
+
+	template <typename Type>
+	SizeType Stack<Type>::capacity() {
+		return maxCount;
+	}
+
+	template <typename Type>
+	void Stack<Type>::resize(SizeType number) {
+		count = number;
+	}
+
 	template <typename Type>
 	void Stack<Type>::clear() {
 		count = 0;
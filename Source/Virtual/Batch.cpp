@@ -0,0 +1,145 @@
+
+/*!
+ *
+ *    + --------------------------------------- +
+ *    |  Batch.cpp                              |
+ *    |                                         |
+ *    |              Batch Runner               |
+ *    |                                         |
+ *    |  Created by Cristian A.                 |
+ *    |  Copyright © MIT. All rights reserved.  |
+ *    + --------------------------------------- +
+ *
+ *    Note: This software is licensed under
+ *          the (MIT) Massachusetts Institute
+ *          of Technology License.
+ *
+!*/
+
+#include "Batch.hpp"
+
+#ifndef SPIN_BATCH_CPP
+#define SPIN_BATCH_CPP
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "Processor.hpp"
+
+namespace Spin {
+
+	// Indices of the jobs dealt to a worker:
+	class Queue {
+		private:
+		std::deque<SizeType> jobs;
+		std::mutex lock;
+		public:
+		void push(SizeType job) {
+			jobs.push_back(job);
+		}
+		Boolean take(SizeType & job) {
+			std::lock_guard<std::mutex> guard(lock);
+			if (jobs.empty()) return false;
+			job = jobs.front();
+			jobs.pop_front();
+			return true;
+		}
+		Boolean steal(SizeType & job) {
+			std::lock_guard<std::mutex> guard(lock);
+			if (jobs.empty()) return false;
+			job = jobs.back();
+			jobs.pop_back();
+			return true;
+		}
+	};
+
+	Batch::Report Batch::run(Array<Job> & jobs, SizeType workers,
+							 Collector::Options heap, Boolean compiling) {
+		Report report;
+		report.jobs = jobs.size();
+		if (jobs.empty()) return report;
+		workers = std::clamp<SizeType>(workers, 1, jobs.size());
+		report.workers = workers;
+		Array<Queue> queues(workers);
+		for (SizeType w = 0; w < workers; w += 1) {
+			const SizeType begin = w * jobs.size() / workers;
+			const SizeType end = (w + 1) * jobs.size() / workers;
+			for (SizeType j = begin; j < end; j += 1) queues[w].push(j);
+		}
+		// No job creates others, so a worker that finds
+		// every queue empty has nothing left to do:
+		const auto work = [&] (SizeType w) {
+			std::ostringstream output;
+			std::istringstream input;
+			const auto flags = output.flags();
+			const auto precision = output.precision();
+			Processor processor(output, input);
+			processor.heap = heap;
+			SizeType index = 0;
+			while (true) {
+				Boolean found = queues[w].take(index);
+				for (SizeType o = 1; !found && o < workers; o += 1) {
+					found = queues[(w + o) % workers].steal(index);
+				}
+				if (!found) return;
+				Job & job = jobs[index];
+				output.str(String());
+				output.clear();
+				output.flags(flags);
+				output.precision(precision);
+				input.str(job.input);
+				input.clear();
+				const auto start = std::chrono::steady_clock::now();
+				try { processor.run(job.program, compiling); }
+				catch (Processor::Crash & c) {
+					job.crashed = true;
+					job.address = c.getAddress();
+					job.instruction = c.getInstruction();
+				}
+				const auto stop = std::chrono::steady_clock::now();
+				job.milliseconds = std::chrono::duration<Real, std::milli>(
+					stop - start
+				).count();
+				job.output = output.str();
+			}
+		};
+		const auto start = std::chrono::steady_clock::now();
+		Array<std::thread> threads;
+		for (SizeType w = 1; w < workers; w += 1) {
+			threads.emplace_back(work, w);
+		}
+		work(0);
+		for (std::thread & thread : threads) thread.join();
+		const auto stop = std::chrono::steady_clock::now();
+		report.milliseconds = std::chrono::duration<Real, std::milli>(
+			stop - start
+		).count();
+		Array<Real> latencies;
+		latencies.reserve(jobs.size());
+		for (Job & job : jobs) {
+			latencies.push_back(job.milliseconds);
+			if (job.crashed) report.crashes += 1;
+		}
+		std::sort(latencies.begin(), latencies.end());
+		// Nearest rank:
+		const auto percentile = [&latencies] (SizeType p) {
+			const SizeType rank = (p * latencies.size() + 99) / 100;
+			return latencies[std::max<SizeType>(rank, 1) - 1];
+		};
+		report.median = percentile(50);
+		report.p90 = percentile(90);
+		report.p99 = percentile(99);
+		report.maximum = latencies.back();
+		if (report.milliseconds > 0.0) {
+			report.throughput = report.jobs * 1000.0 / report.milliseconds;
+		}
+		return report;
+	}
+
+}
+
+#endif
@@ -0,0 +1,60 @@
+
+#include "../Common/Header.hpp"
+
+#ifndef SPIN_BATCH_HPP
+#define SPIN_BATCH_HPP
+
+#include "../Compiler/Program.hpp"
+#include "Collector.hpp"
+
+namespace Spin {
+
+	// Runs many jobs on a pool of threads, each one
+	// owning its Processor. Jobs are dealt in equal
+	// runs to the workers, which take them from the
+	// front of their own queue and, once it's empty,
+	// steal from the back of the others. Programs
+	// are only read, so jobs can share them.
+
+	class Batch {
+
+		public:
+
+		struct Job {
+			Program * program = nullptr;
+			// Contents of the input stream:
+			String input;
+			// Everything the program wrote:
+			String output;
+			Boolean crashed = false;
+			SizeType address = 0;
+			ByteCode instruction;
+			Real milliseconds = 0.0;
+		};
+
+		struct Report {
+			SizeType jobs = 0;
+			SizeType crashes = 0;
+			SizeType workers = 0;
+			// Wall time of the whole batch:
+			Real milliseconds = 0.0;
+			// Jobs per second:
+			Real throughput = 0.0;
+			// Latencies of a single job:
+			Real median = 0.0;
+			Real p90 = 0.0;
+			Real p99 = 0.0;
+			Real maximum = 0.0;
+		};
+
+		Batch() = delete;
+
+		static Report run(Array<Job> & jobs, SizeType workers,
+						  Collector::Options heap,
+						  Boolean compiling = false);
+
+	};
+
+}
+
+#endif
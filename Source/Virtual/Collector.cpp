@@ -0,0 +1,91 @@
+
+/*!
+ *
+ *    + --------------------------------------- +
+ *    |  Collector.cpp                          |
+ *    |                                         |
+ *    |            Garbage Collector            |
+ *    |                                         |
+ *    |  Created by Cristian A.                 |
+ *    |  Copyright © MIT. All rights reserved.  |
+ *    + --------------------------------------- +
+ *
+ *    Note: This software is licensed under
+ *          the (MIT) Massachusetts Institute
+ *          of Technology License.
+ *
+!*/
+
+#include "Collector.hpp"
+
+#ifndef SPIN_COLLECTOR_CPP
+#define SPIN_COLLECTOR_CPP
+
+#include <chrono>
+#include <iostream>
+
+#include "../Common/Interface.hpp"
+
+namespace Spin {
+
+	void Collector::mark(Value value, Array<Array<Value> *> & gray) {
+		if (complexes.mark(value.pointer)) return;
+		if (strings.mark(value.pointer)) return;
+		Array<Value> * array = arrays.mark(value.pointer);
+		if (array) gray.push_back(array);
+	}
+
+	void Collector::collect(const Value * begin, const Value * end,
+							std::initializer_list<Value> registers) {
+		const auto start = std::chrono::steady_clock::now();
+		// Mark:
+		Array<Array<Value> *> gray;
+		for (const Value * value = begin; value < end; value += 1) {
+			mark(* value, gray);
+		}
+		for (const Value & value : registers) mark(value, gray);
+		while (!gray.empty()) {
+			Array<Value> * array = gray.back();
+			gray.pop_back();
+			for (const Value & value : * array) mark(value, gray);
+		}
+		// Sweep:
+		const SizeType freed = complexes.sweep() +
+							   strings.sweep() +
+							   arrays.sweep();
+		const SizeType kept = size();
+		limit = std::max(options.threshold, (SizeType)(kept * options.growth));
+		const Real milliseconds = std::chrono::duration<Real, std::milli>(
+			std::chrono::steady_clock::now() - start
+		).count();
+		statistics.collections += 1;
+		statistics.freed += freed;
+		statistics.milliseconds += milliseconds;
+		if (!options.logging) return;
+		EStream << "% GC collection " << statistics.collections
+				<< " % kept " << kept << ", freed " << freed
+				<< " objects in " << milliseconds << " ms, next at "
+				<< limit << "." << endLine;
+	}
+
+	void Collector::clear() {
+		const SizeType freed = size();
+		complexes.reset();
+		strings.reset();
+		arrays.reset();
+		limit = 0;
+		if (options.logging && statistics.allocated) {
+			EStream << "% GC statistics % " << statistics.collections
+					<< " collections, " << statistics.allocated
+					<< " objects allocated, " << statistics.freed + freed
+					<< " freed (" << freed << " at exit), peak of "
+					<< statistics.peak << " live objects, "
+					<< statistics.milliseconds << " ms collecting."
+					<< endLine;
+		}
+		statistics = Statistics();
+	}
+
+}
+
+#endif
@@ -0,0 +1,123 @@
+
+#include "../Common/Header.hpp"
+
+#ifndef SPIN_COLLECTOR_HPP
+#define SPIN_COLLECTOR_HPP
+
+#include <initializer_list>
+
+#include "../Compiler/Program.hpp"
+#include "../Types/Complex.hpp"
+#include "../Utility/Pool.hpp"
+
+namespace Spin {
+
+	// Mark and sweep collector of the objects that
+	// the Processor allocates (strings, complex
+	// numbers and arrays). Values don't carry their
+	// type, so roots are found conservatively: any
+	// value on the stack or in a temporary register
+	// holding the address of a live object keeps it
+	// alive, and so does any element of a live array.
+	// An integer that happens to match an address
+	// only delays the release of an object.
+	// Collections only happen at safe points of the
+	// Processor (calls and loops), when the objects
+	// allocated since the last one reach the limit.
+	// Every type has its own Pool (see Pool.hpp), so
+	// objects don't go through the general heap and
+	// the end of a run gives back all of them at once.
+
+	class Collector {
+
+		public:
+
+		struct Options {
+			// Objects before the first collection:
+			SizeType threshold = 4096;
+			// The next limit is the survivors times this:
+			Real growth = 2.0;
+			// Statistics on the error stream:
+			Boolean logging = false;
+		};
+
+		struct Statistics {
+			SizeType collections = 0;
+			SizeType allocated = 0;
+			SizeType freed = 0;
+			SizeType peak = 0;
+			Real milliseconds = 0.0;
+		};
+
+		private:
+
+		Pool<Complex> complexes;
+		Pool<String> strings;
+		Pool<Array<Value>> arrays;
+
+		SizeType limit = 0;
+
+		void mark(Value value, Array<Array<Value> *> & gray);
+
+		inline void count() {
+			if (!limit) limit = options.threshold;
+			statistics.allocated += 1;
+			statistics.peak = std::max(statistics.peak, size());
+		}
+
+		public:
+
+		Options options;
+		Statistics statistics;
+
+		Collector() = default;
+
+		Collector(const Collector &) = delete;
+		Collector & operator = (const Collector &) = delete;
+
+		template <typename ... Arguments>
+		inline Complex * complex(Arguments && ... arguments) {
+			Complex * complex = complexes.make(
+				std::forward<Arguments>(arguments) ...
+			);
+			count();
+			return complex;
+		}
+		template <typename ... Arguments>
+		inline String * string(Arguments && ... arguments) {
+			String * string = strings.make(
+				std::forward<Arguments>(arguments) ...
+			);
+			count();
+			return string;
+		}
+		template <typename ... Arguments>
+		inline Array<Value> * array(Arguments && ... arguments) {
+			Array<Value> * array = arrays.make(
+				std::forward<Arguments>(arguments) ...
+			);
+			count();
+			return array;
+		}
+
+		inline SizeType size() const {
+			return complexes.size() + strings.size() + arrays.size();
+		}
+
+		inline Boolean full() const {
+			return limit && size() >= limit;
+		}
+
+		// Marks from the values in [begin, end) and the
+		// registers, then frees everything unmarked:
+		void collect(const Value * begin, const Value * end,
+					 std::initializer_list<Value> registers);
+
+		// Frees every object and closes the statistics:
+		void clear();
+
+	};
+
+}
+
+#endif
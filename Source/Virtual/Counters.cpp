@@ -0,0 +1,158 @@
+
+/*!
+ *
+ *    + --------------------------------------- +
+ *    |  Counters.cpp                           |
+ *    |                                         |
+ *    |             Opcode Counters             |
+ *    |                                         |
+ *    |  Created by Cristian A.                 |
+ *    |  Copyright © MIT. All rights reserved.  |
+ *    + --------------------------------------- +
+ *
+ *    Note: This software is licensed under
+ *          the (MIT) Massachusetts Institute
+ *          of Technology License.
+ *
+!*/
+
+#include "Counters.hpp"
+
+#ifndef SPIN_COUNTERS_CPP
+#define SPIN_COUNTERS_CPP
+
+#include <algorithm>
+#include <bit>
+#include <sstream>
+
+#include "../Common/Interface.hpp"
+#include "../Compiler/Decompiler.hpp"
+#include "../Manager/Manager.hpp"
+
+namespace Spin {
+
+	#if defined(__x86_64__)
+		const Boolean Counters::cycles = true;
+	#else
+		const Boolean Counters::cycles = false;
+	#endif
+
+	Counters::Counters(Boolean timing): timing(timing) { }
+
+	void Counters::close(UInt64 now) {
+		const UInt64 elapsed = now - start;
+		ticks[previous] += elapsed;
+		const SizeType bucket = elapsed ? std::bit_width(elapsed) - 1 : 0;
+		histograms[previous][std::min(bucket, buckets - 1)] += 1;
+	}
+
+	void Counters::stop() {
+		if (running) close(tick());
+		running = false;
+	}
+
+	// Names the operand of a typed entry:
+	static String operand(UInt32 key) {
+		const UInt8 code = key >> 16;
+		const UInt16 value = key & 0xFFFF;
+		if (Encoding::operand(code) == Encoding::Operand::types) {
+			return Decompiler::resolve((Type)(value >> 8)) + " " +
+				   Decompiler::resolve((Type)(value & 0xFF));
+		}
+		if (code == OPCode::INT) return std::to_string(value);
+		return Decompiler::resolve((Type) value);
+	}
+
+	// Sorted by executions, the most frequent first:
+	static Array<Pair<UInt32, UInt64>> sort(const Array<UInt64> & counts) {
+		Array<Pair<UInt32, UInt64>> sorted;
+		for (UInt32 i = 0; i < counts.size(); i += 1) {
+			if (counts[i]) sorted.push_back({ i, counts[i] });
+		}
+		std::stable_sort(sorted.begin(), sorted.end(), [] (auto & a, auto & b) {
+			return a.second > b.second;
+		});
+		return sorted;
+	}
+	static Array<Pair<UInt32, UInt64>> sort(const Dictionary<UInt32, UInt64> & counts) {
+		Array<Pair<UInt32, UInt64>> sorted(counts.begin(), counts.end());
+		std::sort(sorted.begin(), sorted.end(), [] (auto & a, auto & b) {
+			if (a.second != b.second) return a.second > b.second;
+			return a.first < b.first;
+		});
+		return sorted;
+	}
+
+	void Counters::print(std::ostream & stream) const {
+		UInt64 total = 0;
+		for (UInt64 count : executions) total += count;
+		const auto flags = stream.flags();
+		const auto precision = stream.precision();
+		stream << endLine << "% Opcode Counters %" << endLine
+			   << "Instructions: " << total << "." << endLine
+			   << std::fixed << std::setprecision(2);
+		for (auto & entry : sort(executions)) {
+			stream << std::left << std::setw(10)
+				   << Decompiler::mnemonic((OPCode) entry.first)
+				   << std::right << std::setw(16) << entry.second
+				   << std::setw(9) << entry.second * 100.0 / total << "%";
+			if (timing) {
+				stream << std::setw(12) << (Real) ticks[entry.first] / entry.second
+					   << (cycles ? " cycles" : " ns");
+			}
+			stream << endLine;
+		}
+		stream << endLine << "% Typed Opcodes %" << endLine;
+		for (auto & entry : sort(typed)) {
+			const UInt8 code = entry.first >> 16;
+			stream << std::left << std::setw(4)
+				   << Decompiler::mnemonic((OPCode) code)
+				   << std::setw(10) << operand(entry.first)
+				   << std::right << std::setw(12) << entry.second
+				   << std::setw(9) << entry.second * 100.0 / executions[code]
+				   << "%" << endLine;
+		}
+		stream << endLine;
+		stream.flags(flags);
+		stream.precision(precision);
+	}
+
+	void Counters::report(String path) const {
+		std::stringstream json;
+		json << "{" << endLine
+			 << "\t\"timing\": " << (timing ? "true" : "false") << "," << endLine
+			 << "\t\"ticks\": \"" << (cycles ? "cycles" : "nanoseconds")
+			 << "\"," << endLine << "\t\"opcodes\": [";
+		Boolean first = true;
+		for (auto & entry : sort(executions)) {
+			json << (first ? "" : ",") << endLine << "\t\t{ \"opcode\": \""
+				 << Decompiler::mnemonic((OPCode) entry.first)
+				 << "\", \"executions\": " << entry.second;
+			if (timing) {
+				json << ", \"ticks\": " << ticks[entry.first]
+					 << ", \"histogram\": [";
+				const Array<UInt64> & histogram = histograms[entry.first];
+				for (SizeType i = 0; i < buckets; i += 1) {
+					json << (i ? ", " : "") << histogram[i];
+				}
+				json << "]";
+			}
+			json << " }";
+			first = false;
+		}
+		json << endLine << "\t]," << endLine << "\t\"typed\": [";
+		first = true;
+		for (auto & entry : sort(typed)) {
+			json << (first ? "" : ",") << endLine << "\t\t{ \"opcode\": \""
+				 << Decompiler::mnemonic((OPCode)(entry.first >> 16))
+				 << "\", \"operand\": \"" << operand(entry.first)
+				 << "\", \"executions\": " << entry.second << " }";
+			first = false;
+		}
+		json << endLine << "\t]" << endLine << "}" << endLine;
+		Manager::createNewFile(path, json.str());
+	}
+
+}
+
+#endif
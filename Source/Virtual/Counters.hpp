@@ -0,0 +1,104 @@
+
+#include "../Common/Header.hpp"
+
+#ifndef SPIN_COUNTERS_HPP
+#define SPIN_COUNTERS_HPP
+
+#include <chrono>
+#include <ostream>
+
+#include "../Compiler/Program.hpp"
+#include "Encoding.hpp"
+
+#if defined(__x86_64__)
+	#include <x86intrin.h>
+#endif
+
+namespace Spin {
+
+	// Executions of every opcode and of every opcode
+	// with its type operands, filled by a Processor
+	// built with -DSPIN_COUNT (every other build has
+	// no trace of it). With timing, the ticks between
+	// two dispatches go to the first instruction and
+	// to its histogram. Ticks are cycles (rdtsc) on
+	// x86-64 and nanoseconds everywhere else. Native
+	// code (see Jit.hpp) isn't counted.
+
+	class Counters {
+
+		public:
+
+		static const Boolean cycles;
+
+		// The i-th bucket of a histogram counts the
+		// instructions that took [2^i, 2^(i + 1)) ticks:
+		static constexpr SizeType buckets = 32;
+
+		private:
+
+		Boolean timing = false;
+		Boolean running = false;
+		UInt8 previous = 0;
+		UInt64 start = 0;
+
+		static inline UInt64 tick() {
+			#if defined(__x86_64__)
+			return __rdtsc();
+			#else
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()
+			).count();
+			#endif
+		}
+
+		void close(UInt64 now);
+
+		public:
+
+		Array<UInt64> executions = Array<UInt64>(OPCode::TLT);
+		Array<UInt64> ticks = Array<UInt64>(OPCode::TLT);
+		Array<Array<UInt64>> histograms = Array<Array<UInt64>>(
+			OPCode::TLT, Array<UInt64>(buckets)
+		);
+		// Keyed by the opcode in the high half and the
+		// operand (Type or Types) in the low half:
+		Dictionary<UInt32, UInt64> typed;
+
+		Counters(Boolean timing = false);
+
+		// Called before every instruction:
+		inline void record(const UInt8 * data) {
+			const UInt8 code = * data;
+			if (code >= OPCode::TLT) return;
+			executions[code] += 1;
+			switch (Encoding::operand(code)) {
+				case Encoding::Operand::type:
+					typed[(code << 16) | data[1]] += 1;
+				break;
+				case Encoding::Operand::types:
+					typed[(code << 16) | Encoding::readTypes(data)] += 1;
+				break;
+				default: break;
+			}
+			if (!timing) return;
+			const UInt64 now = tick();
+			if (running) close(now);
+			running = true;
+			previous = code;
+			start = now;
+		}
+
+		// Closes the last instruction of a run:
+		void stop();
+
+		// Table sorted by executions:
+		void print(std::ostream & stream) const;
+		// Same data in JSON:
+		void report(String path) const;
+
+	};
+
+}
+
+#endif
@@ -0,0 +1,120 @@
+
+/*!
+ *
+ *    + --------------------------------------- +
+ *    |  Encoding.cpp                           |
+ *    |                                         |
+ *    |            Bytecode Encoding            |
+ *    |                                         |
+ *    |  Created by Cristian A.                 |
+ *    |  Copyright © MIT. All rights reserved.  |
+ *    + --------------------------------------- +
+ *
+ *    Note: This software is licensed under
+ *          the (MIT) Massachusetts Institute
+ *          of Technology License.
+ *
+!*/
+
+#include "Encoding.hpp"
+
+#ifndef SPIN_ENCODING_CPP
+#define SPIN_ENCODING_CPP
+
+#include <algorithm>
+
+namespace Spin {
+
+	Encoding::Encoding(const Program * program) {
+		const Array<ByteCode> & instructions = program -> instructions;
+		const SizeType count = instructions.size();
+		offsets.reserve(count + 1);
+		SizeType size = 0;
+		for (const ByteCode & byte : instructions) {
+			offsets.push_back(size);
+			size += lengths.of[byte.code];
+		}
+		offsets.push_back(size);
+		code.reserve(size + 1);
+		Dictionary<Integer, SizeType> pool;
+		// SSS is the only instruction that changes a
+		// string in place: without it every literal can
+		// be shared, otherwise only the ones that can't
+		// escape, because the next instruction consumes
+		// them into a new value (or into the output):
+		const Boolean mutating = std::any_of(
+			instructions.begin(), instructions.end(),
+			[] (const ByteCode & byte) { return byte.code == OPCode::SSS; }
+		);
+		const auto consumed = [&] (SizeType i) {
+			if (i + 1 >= count) return false;
+			switch (instructions[i + 1].code) {
+				case OPCode::ADD: case OPCode::EQL:
+				case OPCode::NEQ: return true;
+				case OPCode::TYP:
+					if (i + 2 >= count) return false;
+					if (instructions[i + 2].code != OPCode::INT) return false;
+					switch ((Interrupt) instructions[i + 2].as.type) {
+						case Interrupt::write:
+						case Interrupt::writeln: return true;
+						default: return false;
+					}
+				default: return false;
+			}
+		};
+		const auto write = [&] (auto value) {
+			UInt8 bytes[sizeof(value)];
+			std::memcpy(bytes, & value, sizeof(value));
+			code.insert(code.end(), bytes, bytes + sizeof(value));
+		};
+		for (SizeType i = 0; i < count; i += 1) {
+			const ByteCode & byte = instructions[i];
+			code.push_back(byte.code);
+			switch (operand(byte.code)) {
+				case Operand::none: break;
+				case Operand::type: write((std::uint8_t) byte.as.type); break;
+				case Operand::types: write((std::uint16_t) byte.as.types); break;
+				case Operand::index: {
+					SizeType index = byte.as.index;
+					switch (byte.code) {
+						case OPCode::JMP: case OPCode::JIF:
+						case OPCode::JAF: case OPCode::JIT:
+						case OPCode::JAT: case OPCode::CAL:
+						case OPCode::JEQ: case OPCode::JNE:
+						case OPCode::JGR: case OPCode::JLS:
+						case OPCode::JGE: case OPCode::JLE:
+						case OPCode::TCL:
+							index = offsets[std::min(index, count)];
+						break;
+						case OPCode::STR:
+							if (!mutating || consumed(i)) index |= shared;
+						break;
+						default: break;
+					}
+					write((std::uint32_t) index);
+				} break;
+				case Operand::pair: write((std::uint64_t) byte.as.index); break;
+				case Operand::constant: {
+					auto search = pool.find(byte.as.value.integer);
+					if (search == pool.end()) {
+						search = pool.insert({
+							byte.as.value.integer, constants.size()
+						}).first;
+						constants.push_back(byte.as.value);
+					}
+					write((std::uint32_t) search -> second);
+				} break;
+			}
+		}
+		code.push_back(end);
+	}
+
+	SizeType Encoding::address(SizeType offset) const {
+		auto found = std::upper_bound(offsets.begin(), offsets.end(), offset);
+		if (found == offsets.begin()) return 0;
+		return (SizeType)(found - offsets.begin()) - 1;
+	}
+
+}
+
+#endif
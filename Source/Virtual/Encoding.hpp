@@ -0,0 +1,144 @@
+
+#include "../Common/Header.hpp"
+
+#ifndef SPIN_ENCODING_HPP
+#define SPIN_ENCODING_HPP
+
+#include <cstdint>
+#include <cstring>
+
+#include "../Compiler/Program.hpp"
+
+namespace Spin {
+
+	// The in-memory code of the Processor: every
+	// instruction is a single byte followed by an
+	// operand as wide as it needs (0, 1, 2, 4 or 8
+	// bytes). Constants live in a separate pool and
+	// are pushed through their index. Jumps and calls
+	// are rewritten to byte offsets, while lamda
+	// addresses keep pointing to the instructions
+	// and are looked up in the offsets table.
+
+	class Encoding {
+
+		public:
+
+		enum Operand: UInt8 {
+			none,     // 0 bytes
+			type,     // 1 byte
+			types,    // 2 bytes
+			index,    // 4 bytes
+			pair,     // 8 bytes
+			constant, // 4 bytes, index in the pool
+		};
+
+		static constexpr Operand operand(UInt8 code) {
+			switch (code) {
+				case OPCode::TYP: case OPCode::NEG:
+				case OPCode::INV: case OPCode::BSR:
+				case OPCode::BSL: case OPCode::BRR:
+				case OPCode::BRL: case OPCode::INT:
+					return Operand::type;
+				case OPCode::ADD: case OPCode::SUB:
+				case OPCode::MUL: case OPCode::DIV:
+				case OPCode::MOD: case OPCode::EQL:
+				case OPCode::NEQ: case OPCode::GRT:
+				case OPCode::LSS: case OPCode::GEQ:
+				case OPCode::LEQ: case OPCode::BWA:
+				case OPCode::BWO: case OPCode::BWX:
+				case OPCode::CLL: case OPCode::CST:
+					return Operand::types;
+				case OPCode::STR: case OPCode::GET:
+				case OPCode::SET: case OPCode::SSF:
+				case OPCode::GLF: case OPCode::SLF:
+				case OPCode::PSA: case OPCode::DSK:
+				case OPCode::JMP: case OPCode::JIF:
+				case OPCode::JAF: case OPCode::JIT:
+				case OPCode::JAT: case OPCode::CAL:
+				case OPCode::JEQ: case OPCode::JNE:
+				case OPCode::JGR: case OPCode::JLS:
+				case OPCode::JGE: case OPCode::JLE:
+				case OPCode::SEP: case OPCode::SFP:
+				case OPCode::TCL:
+					return Operand::index;
+				case OPCode::GTT: case OPCode::GFT:
+				case OPCode::GTC: case OPCode::GFC:
+				case OPCode::ADG: case OPCode::ADF:
+				case OPCode::ICG: case OPCode::ICF:
+					return Operand::pair;
+				case OPCode::PSH:
+					return Operand::constant;
+				default: return Operand::none;
+			}
+		}
+
+		// Length of every instruction, opcode included,
+		// indexed by its first byte:
+
+		struct Lengths {
+			UInt8 of[256] = { };
+			consteval Lengths() {
+				for (SizeType i = 0; i < 256; i += 1) {
+					switch (operand((UInt8) i)) {
+						case Operand::none:     of[i] = 1; break;
+						case Operand::type:     of[i] = 2; break;
+						case Operand::types:    of[i] = 3; break;
+						case Operand::index:    of[i] = 5; break;
+						case Operand::pair:     of[i] = 9; break;
+						case Operand::constant: of[i] = 5; break;
+					}
+				}
+			}
+		};
+
+		static const Lengths lengths;
+
+		// Closes the code, so that running past the
+		// last instruction stops the Processor:
+		static constexpr UInt8 end = 0xFF;
+
+		// Marks the operand of a STR whose literal can be
+		// pushed without a copy (see the constructor):
+		static constexpr SizeType shared = 0x80000000;
+
+		Array<UInt8> code;
+		Array<Value> constants;
+		// Byte offset of every instruction, followed
+		// by the one of the end:
+		Array<SizeType> offsets;
+
+		Encoding() = default;
+		Encoding(const Program * program);
+
+		// Address of the instruction at an offset:
+		SizeType address(SizeType offset) const;
+
+		// Operands are stored unaligned:
+
+		static inline Type readType(const UInt8 * data) {
+			return (Type) data[1];
+		}
+		static inline Types readTypes(const UInt8 * data) {
+			std::uint16_t value;
+			std::memcpy(& value, data + 1, sizeof(value));
+			return (Types) value;
+		}
+		static inline SizeType readIndex(const UInt8 * data) {
+			std::uint32_t value;
+			std::memcpy(& value, data + 1, sizeof(value));
+			return (SizeType) value;
+		}
+		static inline SizeType readPair(const UInt8 * data) {
+			std::uint64_t value;
+			std::memcpy(& value, data + 1, sizeof(value));
+			return (SizeType) value;
+		}
+
+	};
+
+	inline constexpr Encoding::Lengths Encoding::lengths = Encoding::Lengths();
+
+}
+
+#endif
@@ -0,0 +1,24 @@
+
+#include "../Common/Header.hpp"
+
+#ifndef SPIN_FRAME_HPP
+#define SPIN_FRAME_HPP
+
+namespace Spin {
+
+	// Record of a call on the Processor: SSF pushes it
+	// with the base of the caller, the call (CAL, LAM)
+	// fills in the return address and the entry of the
+	// callee and RET pops the whole record. Addresses
+	// are offsets in the Encoding. The entries are only
+	// read by the Profiler to walk the calls.
+
+	struct Frame {
+		SizeType address = 0;
+		SizeType base = 0;
+		SizeType routine = 0;
+	};
+
+}
+
+#endif
@@ -0,0 +1,395 @@
+
+/*!
+ *
+ *    + --------------------------------------- +
+ *    |  Jit.cpp                                |
+ *    |                                         |
+ *    |            Baseline Compiler            |
+ *    |                                         |
+ *    |  Created by Cristian A.                 |
+ *    |  Copyright © MIT. All rights reserved.  |
+ *    + --------------------------------------- +
+ *
+ *    Note: This software is licensed under
+ *          the (MIT) Massachusetts Institute
+ *          of Technology License.
+ *
+!*/
+
+#include "Jit.hpp"
+
+#ifndef SPIN_JIT_CPP
+#define SPIN_JIT_CPP
+
+#include <cstring>
+
+#ifdef SPIN_JIT
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+namespace Spin {
+
+	#ifdef SPIN_JIT
+		const Boolean Jit::supported = true;
+	#else
+		const Boolean Jit::supported = false;
+	#endif
+
+	Jit::Jit(const Encoding * encoding, Boolean enabled, UInt32 hotness):
+		enabled(enabled && supported) {
+		if (!this -> enabled) return;
+		this -> encoding = encoding;
+		this -> hotness = hotness;
+		natives = Array<Pointer>(encoding -> code.size(), nullptr);
+		counters = Array<UInt32>(encoding -> code.size(), 0);
+		// Saves the registers of the caller, loads the
+		// context (r12: stack, r14: frame, r13: top and
+		// r15: limit) and jumps to the entry:
+		prologue = (Native) allocate({
+			0x53,                   // push rbx
+			0x41, 0x54,             // push r12
+			0x41, 0x55,             // push r13
+			0x41, 0x56,             // push r14
+			0x41, 0x57,             // push r15
+			0x48, 0x89, 0xFB,       // mov rbx, rdi
+			0x4C, 0x8B, 0x23,       // mov r12, [rbx]
+			0x4C, 0x8B, 0x73, 0x08, // mov r14, [rbx + 8]
+			0x4C, 0x8B, 0x6B, 0x10, // mov r13, [rbx + 16]
+			0x4C, 0x8B, 0x7B, 0x18, // mov r15, [rbx + 24]
+			0xFF, 0xE6,             // jmp rsi
+		});
+	}
+
+	Jit::~Jit() {
+		#ifdef SPIN_JIT
+		for (auto & page : pages) munmap(page.first, page.second);
+		#endif
+	}
+
+	Pointer Jit::allocate(const Array<UInt8> & code) {
+		#ifdef SPIN_JIT
+		const SizeType page = (SizeType) sysconf(_SC_PAGESIZE);
+		const SizeType size = ((code.size() + page - 1) / page) * page;
+		Pointer memory = mmap(
+			nullptr, size, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, - 1, 0
+		);
+		if (memory == MAP_FAILED) return nullptr;
+		std::memcpy(memory, code.data(), code.size());
+		if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0) {
+			munmap(memory, size);
+			return nullptr;
+		}
+		pages.push_back({ memory, size });
+		return memory;
+		#else
+		return nullptr;
+		#endif
+	}
+
+	void Jit::compile(SizeType entry) {
+		if (!prologue) return;
+		const UInt8 * code = encoding -> code.data();
+		const SizeType size = encoding -> code.size();
+		// Everything reachable from the entry without
+		// following calls, execution can come back to
+		// the instruction after any exit:
+		Array<Boolean> reached(size, false);
+		Array<SizeType> work = { entry };
+		while (!work.empty()) {
+			const SizeType o = work.back();
+			work.pop_back();
+			if (o >= size || reached[o]) continue;
+			reached[o] = true;
+			const UInt8 op = code[o];
+			if (op == Encoding::end) continue;
+			const SizeType next = o + Encoding::lengths.of[op];
+			switch (op) {
+				case OPCode::JMP:
+					work.push_back(Encoding::readIndex(code + o));
+				break;
+				case OPCode::JIF: case OPCode::JIT:
+				case OPCode::JAF: case OPCode::JAT:
+				case OPCode::JEQ: case OPCode::JNE:
+				case OPCode::JGR: case OPCode::JLS:
+				case OPCode::JGE: case OPCode::JLE:
+					work.push_back(Encoding::readIndex(code + o));
+					work.push_back(next);
+				break;
+				case OPCode::RET: case OPCode::TCL:
+				case OPCode::HLT: break;
+				default: work.push_back(next); break;
+			}
+		}
+		Array<UInt8> out;
+		Array<SizeType> labels(size, 0);
+		Array<Pair<SizeType, SizeType>> jumps;
+		Array<SizeType> exits;
+		const auto bytes = [&] (std::initializer_list<UInt8> list) {
+			out.insert(out.end(), list.begin(), list.end());
+		};
+		const auto immediate = [&] (auto value) {
+			UInt8 buffer[sizeof(value)];
+			std::memcpy(buffer, & value, sizeof(value));
+			out.insert(out.end(), buffer, buffer + sizeof(value));
+		};
+		// mov eax, offset; jmp epilogue
+		const auto leave = [&] (SizeType o) {
+			bytes({ 0xB8 }); immediate((std::uint32_t) o);
+			bytes({ 0xE9 }); exits.push_back(out.size());
+			immediate((std::uint32_t) 0);
+		};
+		// Exits before pushing when the stack is full:
+		const auto guard = [&] (SizeType o) {
+			bytes({ 0x4D, 0x39, 0xFD, 0x72, 0x0A }); // cmp r13, r15; jb +10
+			leave(o);
+		};
+		// mov [r13], rax; add r13, 8
+		const auto push = [&] {
+			bytes({ 0x49, 0x89, 0x45, 0x00, 0x49, 0x83, 0xC5, 0x08 });
+		};
+		// op reg, [r12 + index * 8] or [r14 + index * 8]
+		const auto access = [&] (UInt8 op, UInt8 reg, Boolean frame, SizeType index) {
+			if (frame) bytes({ 0x49, op, (UInt8)(0x86 | (reg << 3)) });
+			else bytes({ 0x49, op, (UInt8)(0x84 | (reg << 3)), 0x24 });
+			immediate((std::uint32_t)(index * sizeof(Value)));
+		};
+		// jcc or jmp to the native code of a target:
+		const auto branch = [&] (UInt8 condition, SizeType target) {
+			if (condition) bytes({ 0x0F, condition });
+			else bytes({ 0xE9 });
+			jumps.push_back({ out.size(), target });
+			immediate((std::uint32_t) 0);
+		};
+		// mov rax, [r13 - 16]; ...; mov [r13 - 16], rax; sub r13, 8
+		const auto binary = [&] (std::initializer_list<UInt8> operation) {
+			bytes({ 0x49, 0x8B, 0x45, 0xF0 });
+			bytes(operation);
+			bytes({ 0x49, 0x89, 0x45, 0xF0, 0x49, 0x83, 0xED, 0x08 });
+		};
+		// movsd xmm0, [r13 - 16]; ...; movsd [r13 - 16], xmm0; sub r13, 8
+		const auto real = [&] (UInt8 operation) {
+			bytes({ 0xF2, 0x41, 0x0F, 0x10, 0x45, 0xF0 });
+			bytes({ 0xF2, 0x41, 0x0F, operation, 0x45, 0xF8 });
+			bytes({ 0xF2, 0x41, 0x0F, 0x11, 0x45, 0xF0, 0x49, 0x83, 0xED, 0x08 });
+		};
+		// movzx eax, al; mov [r13 - 16], rax; sub r13, 8
+		const auto boolean = [&] {
+			bytes({ 0x0F, 0xB6, 0xC0, 0x49, 0x89, 0x45, 0xF0, 0x49, 0x83, 0xED, 0x08 });
+		};
+		// mov rax, [r13 - 16]; cmp rax, [r13 - 8]; setcc al
+		const auto compare = [&] (UInt8 condition) {
+			bytes({ 0x49, 0x8B, 0x45, 0xF0, 0x49, 0x3B, 0x45, 0xF8 });
+			bytes({ 0x0F, condition, 0xC0 });
+			boolean();
+		};
+		// ucomisd of the two reals, the unordered cases
+		// (NaN) are false except for 'not equal':
+		const auto comparison = [&] (Boolean swapped, std::initializer_list<UInt8> set) {
+			if (swapped) bytes({ 0xF2, 0x41, 0x0F, 0x10, 0x45, 0xF8, 0x66, 0x41, 0x0F, 0x2E, 0x45, 0xF0 });
+			else bytes({ 0xF2, 0x41, 0x0F, 0x10, 0x45, 0xF0, 0x66, 0x41, 0x0F, 0x2E, 0x45, 0xF8 });
+			bytes(set);
+			boolean();
+		};
+		// mov rax, [r13 - 16]; mov rcx, [r13 - 8]; sub r13, 16; cmp rax, rcx; jcc
+		const auto conditional = [&] (UInt8 condition, SizeType target) {
+			bytes({ 0x49, 0x8B, 0x45, 0xF0, 0x49, 0x8B, 0x4D, 0xF8 });
+			bytes({ 0x49, 0x83, 0xED, 0x10, 0x48, 0x39, 0xC8 });
+			branch(condition, target);
+		};
+		// Indices have to fit in a 32 bit displacement:
+		const auto fits = [] (SizeType index) {
+			return index < (SizeType) 0x0FFFFFFF;
+		};
+		for (SizeType o = 0; o < size; o += 1) {
+			if (!reached[o]) continue;
+			labels[o] = out.size();
+			const UInt8 * data = code + o;
+			const SizeType index = Encoding::lengths.of[* data] == 5 ?
+								   Encoding::readIndex(data) : 0;
+			const SizeType pair = Encoding::lengths.of[* data] == 9 ?
+								  Encoding::readPair(data) : 0;
+			// The low half is a constant for some pairs:
+			const Boolean constant = * data == OPCode::GTC || * data == OPCode::GFC ||
+									 * data == OPCode::ICG || * data == OPCode::ICF;
+			const Boolean wide = !fits(index) || !fits(high(pair)) ||
+								 (!constant && !fits(low(pair)));
+			switch (wide ? Encoding::end : * data) {
+				case OPCode::RST: break;
+				case OPCode::PSH:
+					guard(o);
+					bytes({ 0x48, 0xB8 }); // mov rax, imm64
+					immediate((std::uint64_t) encoding -> constants[index].integer);
+					push();
+				break;
+				case OPCode::TYP:
+					guard(o);
+					bytes({ 0x48, 0xB8 });
+					immediate((std::uint64_t) Encoding::readType(data));
+					push();
+				break;
+				case OPCode::GET: guard(o); access(0x8B, 0, false, index); push(); break;
+				case OPCode::GLF: guard(o); access(0x8B, 0, true, index); push(); break;
+				case OPCode::SET:
+					bytes({ 0x49, 0x8B, 0x45, 0xF8 });
+					access(0x89, 0, false, index);
+				break;
+				case OPCode::SLF:
+					bytes({ 0x49, 0x8B, 0x45, 0xF8 });
+					access(0x89, 0, true, index);
+				break;
+				case OPCode::SEP:
+					bytes({ 0x49, 0x8B, 0x45, 0xF8, 0x49, 0x83, 0xED, 0x08 });
+					access(0x89, 0, false, index);
+				break;
+				case OPCode::SFP:
+					bytes({ 0x49, 0x8B, 0x45, 0xF8, 0x49, 0x83, 0xED, 0x08 });
+					access(0x89, 0, true, index);
+				break;
+				case OPCode::POP: bytes({ 0x49, 0x83, 0xED, 0x08 }); break;
+				case OPCode::DSK:
+					bytes({ 0x49, 0x81, 0xED }); // sub r13, imm32
+					immediate((std::uint32_t)(index * sizeof(Value)));
+				break;
+				case OPCode::DHD:
+					guard(o);
+					bytes({ 0x49, 0x8B, 0x45, 0xF8 });
+					push();
+				break;
+				case OPCode::NOT:
+					// movzx eax, byte [r13 - 8]; xor eax, 1; mov [r13 - 8], rax
+					bytes({ 0x41, 0x0F, 0xB6, 0x45, 0xF8, 0x83, 0xF0, 0x01, 0x49, 0x89, 0x45, 0xF8 });
+				break;
+				case OPCode::PST:
+				case OPCode::PSF:
+					guard(o);
+					bytes({ 0x49, 0xC7, 0x45, 0x00 }); // mov qword [r13], imm32
+					immediate((std::uint32_t)(* data == OPCode::PST));
+					bytes({ 0x49, 0x83, 0xC5, 0x08 });
+				break;
+				case OPCode::JMP: branch(0, index); break;
+				case OPCode::JIF:
+				case OPCode::JIT:
+					// sub r13, 8; cmp byte [r13], 0
+					bytes({ 0x49, 0x83, 0xED, 0x08, 0x41, 0x80, 0x7D, 0x00, 0x00 });
+					branch(* data == OPCode::JIF ? 0x84 : 0x85, index);
+				break;
+				case OPCode::JAF:
+				case OPCode::JAT:
+					// cmp byte [r13 - 8], 0
+					bytes({ 0x41, 0x80, 0x7D, 0xF8, 0x00 });
+					branch(* data == OPCode::JAF ? 0x84 : 0x85, index);
+				break;
+				case OPCode::ADI: binary({ 0x49, 0x03, 0x45, 0xF8 }); break;
+				case OPCode::SBI: binary({ 0x49, 0x2B, 0x45, 0xF8 }); break;
+				case OPCode::MLI: binary({ 0x49, 0x0F, 0xAF, 0x45, 0xF8 }); break;
+				case OPCode::DVI:
+				case OPCode::MDI:
+					// Division by zero crashes in the Processor:
+					bytes({ 0x49, 0x8B, 0x4D, 0xF8, 0x48, 0x85, 0xC9, 0x75, 0x0A });
+					leave(o);
+					// mov rax, [r13 - 16]; cqo; idiv rcx
+					bytes({ 0x49, 0x8B, 0x45, 0xF0, 0x48, 0x99, 0x48, 0xF7, 0xF9 });
+					if (* data == OPCode::DVI) bytes({ 0x49, 0x89, 0x45, 0xF0 });
+					else bytes({ 0x49, 0x89, 0x55, 0xF0 });
+					bytes({ 0x49, 0x83, 0xED, 0x08 });
+				break;
+				case OPCode::ADR: real(0x58); break;
+				case OPCode::SBR: real(0x5C); break;
+				case OPCode::MLR: real(0x59); break;
+				case OPCode::DVR: real(0x5E); break;
+				case OPCode::EQI: compare(0x94); break;
+				case OPCode::NEI: compare(0x95); break;
+				case OPCode::GRI: compare(0x9F); break;
+				case OPCode::LSI: compare(0x9C); break;
+				case OPCode::GEI: compare(0x9D); break;
+				case OPCode::LEI: compare(0x9E); break;
+				// sete al; setnp cl; and al, cl
+				case OPCode::EQR: comparison(false, { 0x0F, 0x94, 0xC0, 0x0F, 0x9B, 0xC1, 0x20, 0xC8 }); break;
+				// setne al; setp cl; or al, cl
+				case OPCode::NER: comparison(false, { 0x0F, 0x95, 0xC0, 0x0F, 0x9A, 0xC1, 0x08, 0xC8 }); break;
+				case OPCode::GRR: comparison(false, { 0x0F, 0x97, 0xC0 }); break;
+				case OPCode::GER: comparison(false, { 0x0F, 0x93, 0xC0 }); break;
+				case OPCode::LSR: comparison(true, { 0x0F, 0x97, 0xC0 }); break;
+				case OPCode::LER: comparison(true, { 0x0F, 0x93, 0xC0 }); break;
+				case OPCode::JEQ: conditional(0x84, index); break;
+				case OPCode::JNE: conditional(0x85, index); break;
+				case OPCode::JGR: conditional(0x8F, index); break;
+				case OPCode::JLS: conditional(0x8C, index); break;
+				case OPCode::JGE: conditional(0x8D, index); break;
+				case OPCode::JLE: conditional(0x8E, index); break;
+				case OPCode::GTT:
+				case OPCode::GFT:
+					guard(o);
+					access(0x8B, 0, * data == OPCode::GFT, high(pair));
+					bytes({ 0x49, 0x89, 0x45, 0x00 });
+					access(0x8B, 0, * data == OPCode::GFT, low(pair));
+					bytes({ 0x49, 0x89, 0x45, 0x08, 0x49, 0x83, 0xC5, 0x10 });
+				break;
+				case OPCode::GTC:
+				case OPCode::GFC:
+					guard(o);
+					access(0x8B, 0, * data == OPCode::GFC, high(pair));
+					bytes({ 0x49, 0x89, 0x45, 0x00 });
+					bytes({ 0x48, 0xC7, 0xC0 }); // mov rax, simm32
+					immediate((std::uint32_t) low(pair));
+					bytes({ 0x49, 0x89, 0x45, 0x08, 0x49, 0x83, 0xC5, 0x10 });
+				break;
+				case OPCode::ADG:
+				case OPCode::ADF:
+					guard(o);
+					access(0x8B, 0, * data == OPCode::ADF, high(pair));
+					access(0x03, 0, * data == OPCode::ADF, low(pair));
+					push();
+				break;
+				case OPCode::ICG:
+				case OPCode::ICF:
+					bytes({ 0x48, 0xC7, 0xC0 });
+					immediate((std::uint32_t) low(pair));
+					access(0x01, 0, * data == OPCode::ICF, high(pair));
+				break;
+				// Everything else runs on the Processor:
+				default: leave(o); break;
+			}
+		}
+		// Stores the top and restores the registers:
+		const SizeType epilogue = out.size();
+		bytes({
+			0x4C, 0x89, 0x6B, 0x10, // mov [rbx + 16], r13
+			0x41, 0x5F,             // pop r15
+			0x41, 0x5E,             // pop r14
+			0x41, 0x5D,             // pop r13
+			0x41, 0x5C,             // pop r12
+			0x5B,                   // pop rbx
+			0xC3,                   // ret
+		});
+		const auto patch = [&] (SizeType position, SizeType target) {
+			const std::int32_t relative = (std::int32_t)(target - (position + 4));
+			std::memcpy(out.data() + position, & relative, sizeof(relative));
+		};
+		for (SizeType exit : exits) patch(exit, epilogue);
+		for (auto & jump : jumps) patch(jump.first, labels[jump.second]);
+		UInt8 * native = (UInt8 *) allocate(out);
+		if (!native) return;
+		for (SizeType o = 0; o < size; o += 1) {
+			if (reached[o] && !natives[o]) natives[o] = native + labels[o];
+		}
+	}
+
+	SizeType Jit::run(Pointer entry, Guarded<Value> & stack, SizeType base) {
+		Value * bottom = stack.data();
+		Context context = {
+			bottom, bottom + base,
+			bottom + stack.size(),
+			// The largest push is two values:
+			bottom + stack.capacity() - 2
+		};
+		const SizeType resume = prologue(& context, entry);
+		stack.resize(context.top - bottom);
+		return resume;
+	}
+
+}
+
+#endif
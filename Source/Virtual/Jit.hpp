@@ -0,0 +1,93 @@
+
+#include "../Common/Header.hpp"
+
+#ifndef SPIN_JIT_HPP
+#define SPIN_JIT_HPP
+
+#include "../Utility/Guarded.hpp"
+#include "Encoding.hpp"
+
+// Native code is only generated for x86-64, every
+// other target keeps interpreting:
+
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__))
+	#define SPIN_JIT
+#endif
+
+namespace Spin {
+
+	// Baseline compiler of the Processor: the code
+	// reachable from a hot entry (a routine called
+	// or a loop taken often enough) is translated by
+	// copying a machine code template for every
+	// instruction. Native code works on the stack of
+	// the Processor, so it can give control back at
+	// any instruction: calls, returns, interrupts and
+	// every instruction without a template exit with
+	// the offset where the Processor has to resume.
+
+	class Jit {
+
+		public:
+
+		static constexpr UInt32 threshold = 64;
+
+		static const Boolean supported;
+
+		private:
+
+		// Shared with the templates, see the prologue:
+		struct Context {
+			Value * stack;
+			Value * frame;
+			Value * top;
+			Value * limit;
+		};
+
+		using Native = SizeType (*)(Context * context, Pointer entry);
+
+		const Encoding * encoding = nullptr;
+		UInt32 hotness = threshold;
+
+		Array<Pointer> natives;
+		Array<UInt32> counters;
+		Array<Pair<Pointer, SizeType>> pages;
+		Native prologue = nullptr;
+
+		Pointer allocate(const Array<UInt8> & code);
+		void compile(SizeType entry);
+
+		public:
+
+		Jit(const Encoding * encoding, Boolean enabled,
+			UInt32 hotness = threshold);
+		~Jit();
+
+		Jit(const Jit &) = delete;
+		Jit & operator = (const Jit &) = delete;
+
+		const Boolean enabled = false;
+
+		// Native code of an instruction, if any:
+		inline Pointer native(SizeType offset) {
+			return natives[offset];
+		}
+		// Native code of an entry, counting its uses
+		// and compiling it once it becomes hot:
+		inline Pointer hot(SizeType offset) {
+			if (natives[offset]) return natives[offset];
+			counters[offset] += 1;
+			if (counters[offset] < hotness) return nullptr;
+			compile(offset);
+			return natives[offset];
+		}
+
+		// Runs native code and returns the offset where
+		// the Processor continues:
+		SizeType run(Pointer entry, Guarded<Value> & stack, SizeType base);
+
+	};
+
+}
+
+#endif
@@ -0,0 +1,434 @@
+
+/*!
+ *
+ *    + --------------------------------------- +
+ *    |  Machine.cpp                            |
+ *    |                                         |
+ *    |            Register Machine             |
+ *    |                                         |
+ *    |  Created by Cristian A.                 |
+ *    |  Copyright © MIT. All rights reserved.  |
+ *    + --------------------------------------- +
+ *
+ *    Note: This software is licensed under
+ *          the (MIT) Massachusetts Institute
+ *          of Technology License.
+ *
+!*/
+
+#include "Machine.hpp"
+
+#ifndef SPIN_MACHINE_CPP
+#define SPIN_MACHINE_CPP
+
+#include <random>
+#include <thread>
+
+#include "Operations.hpp"
+
+namespace Spin {
+
+	Machine::Code::~Code() {
+		for (String * string : strings) delete string;
+	}
+
+	#ifdef SPIN_THREADED
+		#define handle(X) X##Handler: case Operation::X
+		#define dispatch data = code + ip; goto * thread[ip]
+		#define next ip += 1; dispatch
+		#define jump dispatch
+	#else
+		#define handle(X) case Operation::X
+		#define next break
+		#define jump continue
+	#endif
+
+	// Registers are relative to the top of the frame,
+	// or absolute when the high bit is set:
+	#define at(o) (bases[(o) >> 31][(Int32)((o) << 1) >> 1])
+
+	Value Machine::evaluate(Code * program) {
+		if (!program) return { .integer = 0 };
+		// Random Device:
+		std::random_device device;
+		std::mt19937_64 engine(device());
+		std::uniform_int_distribution<Int64> dist;
+		// Registers:
+		const SizeType globals = program -> registers.size();
+		registers = program -> registers;
+		registers.resize(globals + program -> reach + 16);
+		frames.clear();
+		SizeType top = globals, ip = 0;
+		Value * bases[2] = { registers.data() + top, registers.data() };
+		// Main:
+		Value b, c;
+		const SizeType count = program -> instructions.size();
+		const Instruction * code = program -> instructions.data();
+		const Instruction * data = code;
+		const auto crash = [&] {
+			const SizeType address = program -> addresses[ip];
+			throw Processor::Crash(
+				address, program -> program -> instructions[address]
+			);
+		};
+		#ifdef SPIN_THREADED
+		// Threaded Code:
+		static const Pointer handlers[] = {
+			&& MOVHandler, && ADDHandler, && SUBHandler, && MULHandler,
+			&& DIVHandler, && MODHandler, && NEGHandler, && EQLHandler,
+			&& NEQHandler, && GRTHandler, && LSSHandler, && GEQHandler,
+			&& LEQHandler, && NOTHandler, && BWAHandler, && BWOHandler,
+			&& BWXHandler, && BSRHandler, && BSLHandler, && BRRHandler,
+			&& BRLHandler, && CSTHandler, && ADIHandler, && SBIHandler,
+			&& MLIHandler, && DVIHandler, && MDIHandler, && ADRHandler,
+			&& SBRHandler, && MLRHandler, && DVRHandler, && EQIHandler,
+			&& NEIHandler, && GRIHandler, && LSIHandler, && GEIHandler,
+			&& LEIHandler, && EQRHandler, && NERHandler, && GRRHandler,
+			&& LSRHandler, && GERHandler, && LERHandler, && JMPHandler,
+			&& JIFHandler, && JITHandler, && JEQHandler, && JNEHandler,
+			&& JGRHandler, && JLSHandler, && JGEHandler, && JLEHandler,
+			&& CALHandler, && LAMHandler, && RETHandler, && INTHandler,
+			&& HLTHandler,
+		};
+		static_assert(
+			sizeof(handlers) / sizeof(Pointer) == Operation::HLT + 1,
+			"Every operation needs its own threaded handler!"
+		);
+		Array<Pointer> stream(count + 1);
+		for (SizeType i = 0; i < count; i += 1) {
+			stream[i] = handlers[code[i].code];
+		}
+		stream[count] = && endHandler;
+		const Pointer * thread = stream.data();
+		dispatch;
+		#endif
+		while (ip < count) {
+			data = code + ip;
+			switch (data -> code) {
+				handle(MOV): at(data -> a) = at(data -> b); next;
+				handle(ADD):
+					if (!Operations::add(data -> as.types, at(data -> b), at(data -> c), at(data -> a))) {
+						return { .integer = 0 };
+					}
+				next;
+				handle(SUB):
+					if (!Operations::subtract(data -> as.types, at(data -> b), at(data -> c), at(data -> a))) {
+						return { .integer = 0 };
+					}
+				next;
+				handle(MUL):
+					if (!Operations::multiply(data -> as.types, at(data -> b), at(data -> c), at(data -> a))) {
+						return { .integer = 0 };
+					}
+				next;
+				handle(DIV):
+					if (!Operations::divide(data -> as.types, at(data -> b), at(data -> c), at(data -> a), crash)) {
+						return { .integer = 0 };
+					}
+				next;
+				handle(MOD):
+					if (!Operations::modulo(data -> as.types, at(data -> b), at(data -> c), at(data -> a), crash)) {
+						return { .integer = 0 };
+					}
+				next;
+				handle(NEG):
+					if (!Operations::negate(data -> as.type, at(data -> b), at(data -> a))) {
+						return { .integer = 0 };
+					}
+				next;
+				handle(EQL):
+					if (!Operations::equal(data -> as.types, at(data -> b), at(data -> c), at(data -> a))) {
+						return { .integer = 0 };
+					}
+				next;
+				handle(NEQ):
+					if (!Operations::different(data -> as.types, at(data -> b), at(data -> c), at(data -> a))) {
+						return { .integer = 0 };
+					}
+				next;
+				handle(GRT):
+					if (!Operations::greater(data -> as.types, at(data -> b), at(data -> c), at(data -> a))) {
+						return { .integer = 0 };
+					}
+				next;
+				handle(LSS):
+					if (!Operations::less(data -> as.types, at(data -> b), at(data -> c), at(data -> a))) {
+						return { .integer = 0 };
+					}
+				next;
+				handle(GEQ):
+					if (!Operations::greaterEqual(data -> as.types, at(data -> b), at(data -> c), at(data -> a))) {
+						return { .integer = 0 };
+					}
+				next;
+				handle(LEQ):
+					if (!Operations::lessEqual(data -> as.types, at(data -> b), at(data -> c), at(data -> a))) {
+						return { .integer = 0 };
+					}
+				next;
+				handle(NOT): at(data -> a) = { .boolean = !(at(data -> b).boolean) }; next;
+				handle(BWA):
+					if (!Operations::bitwiseAnd(data -> as.types, at(data -> b), at(data -> c), at(data -> a))) {
+						return { .integer = 0 };
+					}
+				next;
+				handle(BWO):
+					if (!Operations::bitwiseOr(data -> as.types, at(data -> b), at(data -> c), at(data -> a))) {
+						return { .integer = 0 };
+					}
+				next;
+				handle(BWX):
+					if (!Operations::bitwiseXor(data -> as.types, at(data -> b), at(data -> c), at(data -> a))) {
+						return { .integer = 0 };
+					}
+				next;
+				handle(BSR):
+					if (!Operations::shiftRight(data -> as.type, at(data -> b), at(data -> c), at(data -> a))) {
+						return { .integer = 0 };
+					}
+				next;
+				handle(BSL):
+					if (!Operations::shiftLeft(data -> as.type, at(data -> b), at(data -> c), at(data -> a))) {
+						return { .integer = 0 };
+					}
+				next;
+				handle(BRR):
+					if (!Operations::rotateRight(data -> as.type, at(data -> b), at(data -> c), at(data -> a))) {
+						return { .integer = 0 };
+					}
+				next;
+				handle(BRL):
+					if (!Operations::rotateLeft(data -> as.type, at(data -> b), at(data -> c), at(data -> a))) {
+						return { .integer = 0 };
+					}
+				next;
+				handle(CST):
+					if (!Operations::cast(data -> as.types, at(data -> b), at(data -> a))) {
+						return { .integer = 0 };
+					}
+				next;
+				// Specialised:
+				handle(ADI):
+					b = at(data -> b);
+					c = at(data -> c);
+					at(data -> a) = { .integer = b.integer + c.integer };
+				next;
+				handle(SBI):
+					b = at(data -> b);
+					c = at(data -> c);
+					at(data -> a) = { .integer = b.integer - c.integer };
+				next;
+				handle(MLI):
+					b = at(data -> b);
+					c = at(data -> c);
+					at(data -> a) = { .integer = (Int64)((UInt64)b.integer * (UInt64)c.integer) };
+				next;
+				handle(DVI):
+					b = at(data -> b);
+					c = at(data -> c);
+					if (!c.integer) crash();
+					at(data -> a) = { .integer = b.integer / c.integer };
+				next;
+				handle(MDI):
+					b = at(data -> b);
+					c = at(data -> c);
+					if (!c.integer) crash();
+					at(data -> a) = { .integer = b.integer % c.integer };
+				next;
+				handle(ADR):
+					b = at(data -> b);
+					c = at(data -> c);
+					at(data -> a) = { .real = b.real + c.real };
+				next;
+				handle(SBR):
+					b = at(data -> b);
+					c = at(data -> c);
+					at(data -> a) = { .real = b.real - c.real };
+				next;
+				handle(MLR):
+					b = at(data -> b);
+					c = at(data -> c);
+					at(data -> a) = { .real = b.real * c.real };
+				next;
+				handle(DVR):
+					b = at(data -> b);
+					c = at(data -> c);
+					at(data -> a) = { .real = b.real / c.real };
+				next;
+				handle(EQI):
+					b = at(data -> b);
+					c = at(data -> c);
+					at(data -> a) = { .boolean = (b.integer == c.integer) };
+				next;
+				handle(NEI):
+					b = at(data -> b);
+					c = at(data -> c);
+					at(data -> a) = { .boolean = (b.integer != c.integer) };
+				next;
+				handle(GRI):
+					b = at(data -> b);
+					c = at(data -> c);
+					at(data -> a) = { .boolean = (b.integer > c.integer) };
+				next;
+				handle(LSI):
+					b = at(data -> b);
+					c = at(data -> c);
+					at(data -> a) = { .boolean = (b.integer < c.integer) };
+				next;
+				handle(GEI):
+					b = at(data -> b);
+					c = at(data -> c);
+					at(data -> a) = { .boolean = (b.integer >= c.integer) };
+				next;
+				handle(LEI):
+					b = at(data -> b);
+					c = at(data -> c);
+					at(data -> a) = { .boolean = (b.integer <= c.integer) };
+				next;
+				handle(EQR):
+					b = at(data -> b);
+					c = at(data -> c);
+					at(data -> a) = { .boolean = (b.real == c.real) };
+				next;
+				handle(NER):
+					b = at(data -> b);
+					c = at(data -> c);
+					at(data -> a) = { .boolean = (b.real != c.real) };
+				next;
+				handle(GRR):
+					b = at(data -> b);
+					c = at(data -> c);
+					at(data -> a) = { .boolean = (b.real > c.real) };
+				next;
+				handle(LSR):
+					b = at(data -> b);
+					c = at(data -> c);
+					at(data -> a) = { .boolean = (b.real < c.real) };
+				next;
+				handle(GER):
+					b = at(data -> b);
+					c = at(data -> c);
+					at(data -> a) = { .boolean = (b.real >= c.real) };
+				next;
+				handle(LER):
+					b = at(data -> b);
+					c = at(data -> c);
+					at(data -> a) = { .boolean = (b.real <= c.real) };
+				next;
+				// Control Flow:
+				handle(JMP): ip = data -> a; jump;
+				handle(JIF): if (!at(data -> b).boolean) { ip = data -> a; jump; } next;
+				handle(JIT): if  (at(data -> b).boolean) { ip = data -> a; jump; } next;
+				handle(JEQ): if (at(data -> b).integer == at(data -> c).integer) { ip = data -> a; jump; } next;
+				handle(JNE): if (at(data -> b).integer != at(data -> c).integer) { ip = data -> a; jump; } next;
+				handle(JGR): if (at(data -> b).integer  > at(data -> c).integer) { ip = data -> a; jump; } next;
+				handle(JLS): if (at(data -> b).integer  < at(data -> c).integer) { ip = data -> a; jump; } next;
+				handle(JGE): if (at(data -> b).integer >= at(data -> c).integer) { ip = data -> a; jump; } next;
+				handle(JLE): if (at(data -> b).integer <= at(data -> c).integer) { ip = data -> a; jump; } next;
+				handle(CAL):
+					frames.push_back({ ip, top });
+					top += (Int32)data -> b;
+					if (top + program -> reach >= registers.size()) {
+						registers.resize(registers.size() * 2);
+						bases[1] = registers.data();
+					}
+					bases[0] = registers.data() + top;
+					ip = data -> a;
+				jump;
+				handle(LAM): {
+					// The lamda holds the stack address of its
+					// body, which crashes the Processor when 0:
+					const SizeType address = (SizeType)(at(data -> a).integer);
+					if (!address || address >= program -> entries.size() ||
+						program -> entries[address] == none) {
+						throw Processor::Crash(
+							address, program -> program -> instructions[
+								program -> addresses[ip]
+							]
+						);
+					}
+					frames.push_back({ ip, top });
+					top += (Int32)data -> b;
+					if (top + program -> reach >= registers.size()) {
+						registers.resize(registers.size() * 2);
+						bases[1] = registers.data();
+					}
+					bases[0] = registers.data() + top;
+					ip = program -> entries[address];
+				} jump;
+				handle(RET):
+					at(data -> a) = at(data -> b);
+					ip = frames.back().ip;
+					top = frames.back().top;
+					frames.pop_back();
+					bases[0] = registers.data() + top;
+				next;
+				handle(INT):
+					switch ((Interrupt)data -> as.type) {
+						case Interrupt::write:
+							if (!Operations::print((Type)at(data -> c).byte, at(data -> b), output)) {
+								return { .integer = 0 };
+							}
+						break;
+						case Interrupt::writeln:
+							if (!Operations::print((Type)at(data -> c).byte, at(data -> b), output)) {
+								return { .integer = 0 };
+							}
+							output.line();
+						break;
+						case Interrupt::sleep:
+							output.flush();
+							std::this_thread::sleep_for(
+								std::chrono::milliseconds(
+									(UInt64)at(data -> b).integer
+								)
+							);
+						break;
+						case Interrupt::clock:
+							at(data -> a) = {
+								.integer = std::chrono::duration_cast
+										   <std::chrono::milliseconds>
+										   (std::chrono::system_clock::now()
+										   .time_since_epoch()).count()
+							};
+						break;
+						case Interrupt::noise:
+							at(data -> a) = { .integer = dist(engine) };
+						break;
+						default: return { .integer = 0 };
+					}
+				next;
+				handle(HLT):
+					frames.clear();
+					return { .integer = 0 };
+				next;
+			}
+			ip += 1;
+		}
+		#ifdef SPIN_THREADED
+		endHandler:
+		#endif
+		return { .integer = 0 };
+	}
+
+	#undef at
+	#undef handle
+	#ifdef SPIN_THREADED
+		#undef dispatch
+	#endif
+	#undef next
+	#undef jump
+
+	void Machine::run(Code * code) {
+		try { evaluate(code); }
+		catch (Processor::Crash & c) {
+			output.flush();
+			throw;
+		}
+		output.flush();
+		frames.clear();
+	}
+
+}
+
+#endif
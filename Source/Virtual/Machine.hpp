@@ -0,0 +1,172 @@
+
+#include "../Common/Interface.hpp"
+
+#ifndef SPIN_MACHINE_HPP
+#define SPIN_MACHINE_HPP
+
+#include "Processor.hpp"
+
+namespace Spin {
+
+	// The register machine executes the three-address
+	// code produced by the Translator. Every operand is
+	// a register: the high bit selects the absolute file
+	// (constants, temporaries and the globals when used
+	// inside routines), otherwise the low bits are a
+	// signed offset from the top of the current frame,
+	// where the stack machine would have its values.
+
+	class Machine {
+
+		public:
+
+		enum Operation: UInt8 {
+
+			MOV, // move
+
+			ADD, // add
+			SUB, // subtract
+			MUL, // multiply
+			DIV, // divide
+			MOD, // modulus
+			NEG, // negate
+
+			EQL, // equal
+			NEQ, // not equal
+			GRT, // great
+			LSS, // less
+			GEQ, // great equal
+			LEQ, // less equal
+
+			NOT, // not
+			BWA, // bitwise and
+			BWO, // bitwise or
+			BWX, // bitwise xor
+			BSR, // bitwise shift right
+			BSL, // bitwise shift left
+			BRR, // bitwise rotation right
+			BRL, // bitwise rotation left
+
+			CST, // cast
+
+			// Specialised:
+
+			ADI, // add integer
+			SBI, // subtract integer
+			MLI, // multiply integer
+			DVI, // divide integer
+			MDI, // modulus integer
+			ADR, // add real
+			SBR, // subtract real
+			MLR, // multiply real
+			DVR, // divide real
+			EQI, // equal integer
+			NEI, // not equal integer
+			GRI, // great integer
+			LSI, // less integer
+			GEI, // great equal integer
+			LEI, // less equal integer
+			EQR, // equal real
+			NER, // not equal real
+			GRR, // great real
+			LSR, // less real
+			GER, // great equal real
+			LER, // less equal real
+
+			// Control Flow:
+
+			JMP, // jump
+			JIF, // jump if false
+			JIT, // jump if true
+			JEQ, // jump if equal
+			JNE, // jump if not equal
+			JGR, // jump if great
+			JLS, // jump if less
+			JGE, // jump if great equal
+			JLE, // jump if less equal
+
+			CAL, // call
+			LAM, // lamda call
+			RET, // return
+			INT, // interrupt
+			HLT, // halt
+
+		};
+
+		// Operands: 'a' is the destination (or the jump
+		// target), 'b' and 'c' the sources (or the frame
+		// shift of a call):
+
+		struct Instruction {
+			Operation code;
+			union { Type type; Types types; } as;
+			UInt32 a = 0, b = 0, c = 0;
+		};
+
+		static constexpr UInt32 absolute = 0x80000000;
+
+		static constexpr UInt32 global(SizeType index) {
+			return (UInt32)(absolute | index);
+		}
+		static constexpr UInt32 local(Int64 offset) {
+			return (UInt32)(offset & 0x7FFFFFFF);
+		}
+
+		class Code {
+			public:
+			Array<Instruction> instructions;
+			// Stack address of every instruction, to
+			// report crashes as the Processor does:
+			Array<SizeType> addresses;
+			// Register address of every stack address
+			// that can be reached by a lamda call:
+			Array<UInt32> entries;
+			// Constants and temporary registers, the
+			// main frame starts right after them:
+			Array<Value> registers;
+			Array<String *> strings;
+			// Deepest frame offset used by the code:
+			SizeType reach = 0;
+			Program * program = nullptr;
+			Code() = default;
+			~Code();
+		};
+
+		static constexpr UInt32 none = 0xFFFFFFFF;
+
+		private:
+
+		Array<Value> registers;
+
+		struct Frame {
+			SizeType ip;
+			SizeType top;
+		};
+
+		Array<Frame> frames;
+
+		Output output = Output(OStream, Output::terminal(OStream));
+
+		Machine() = default;
+		~Machine() = default;
+
+		Value evaluate(Code * code);
+
+		public:
+
+		Machine(const Machine &) = delete;
+		Machine(Machine &&) = delete;
+		Machine & operator = (const Machine &) = delete;
+		Machine & operator = (Machine &&) = delete;
+		static Machine * self() {
+			static Machine instance;
+			return & instance;
+		}
+
+		void run(Code * code);
+
+	};
+
+}
+
+#endif
@@ -0,0 +1,852 @@
+
+#include "../Common/Interface.hpp"
+
+#ifndef SPIN_OPERATIONS_PURE
+#define SPIN_OPERATIONS_PURE
+
+#include "../Compiler/Program.hpp"
+#include "../Utility/Converter.hpp"
+#include "../Types/Complex.hpp"
+#include "Output.hpp"
+
+namespace Spin {
+
+	// Operations on basic types shared by every engine.
+	// Each one writes its result and returns true, or
+	// returns false when the types aren't basic (the
+	// caller handles objects). Division and modulo call
+	// the given crash function on a zero divisor.
+
+	class Operations {
+
+		private:
+
+		static consteval Types compose(Type a, Type b) {
+			return (Types)(((Types) a << 8) | b);
+		}
+
+		public:
+
+		Operations() = delete;
+
+		static inline Boolean add(Types types, Value a, Value b, Value & result) {
+			switch (types) {
+				case compose(Type::CharacterType, Type::CharacterType):
+				case compose(Type::CharacterType, Type::ByteType):
+				case compose(Type::ByteType, Type::CharacterType):
+				case compose(Type::ByteType, Type::ByteType):
+					result = { .integer = (Int64)((Int64)(a.byte) + (Int64)(b.byte)) };
+				return true;
+				case compose(Type::CharacterType, Type::IntegerType):
+				case compose(Type::CharacterType, Type::NaturalType):
+				case compose(Type::ByteType, Type::IntegerType):
+				case compose(Type::ByteType, Type::NaturalType):
+					result = { .integer = (Int64)((Int64)(a.byte) + b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::CharacterType):
+				case compose(Type::IntegerType, Type::CharacterType):
+				case compose(Type::NaturalType, Type::ByteType):
+				case compose(Type::IntegerType, Type::ByteType):
+					result = { .integer = (Int64)(a.integer + (Int64)(b.byte)) };
+				return true;
+				case compose(Type::NaturalType, Type::NaturalType):
+				case compose(Type::IntegerType, Type::IntegerType):
+				case compose(Type::IntegerType, Type::NaturalType):
+				case compose(Type::NaturalType, Type::IntegerType):
+					result = { .integer = a.integer + b.integer };
+				return true;
+				case compose(Type::NaturalType, Type::RealType):
+					result = { .real = ((UInt64)a.integer) + b.real };
+				return true;
+				case compose(Type::IntegerType, Type::RealType):
+					result = { .real = a.integer + b.real };
+				return true;
+				case compose(Type::RealType, Type::NaturalType):
+					result = { .real = a.real + ((UInt64)b.integer) };
+				return true;
+				case compose(Type::RealType, Type::IntegerType):
+					result = { .real = a.real + b.integer };
+				return true;
+				case compose(Type::RealType, Type::RealType):
+				case compose(Type::ImaginaryType, Type::ImaginaryType):
+					result = { .real = a.real + b.real };
+				return true;
+				default: return false;
+			}
+		}
+
+		static inline Boolean subtract(Types types, Value a, Value b, Value & result) {
+			switch (types) {
+				case compose(Type::CharacterType, Type::CharacterType):
+				case compose(Type::CharacterType, Type::ByteType):
+				case compose(Type::ByteType, Type::CharacterType):
+				case compose(Type::ByteType, Type::ByteType):
+					result = { .integer = (Int64)((Int64)(a.byte) - (Int64)(b.byte)) };
+				return true;
+				case compose(Type::CharacterType, Type::NaturalType):
+				case compose(Type::CharacterType, Type::IntegerType):
+				case compose(Type::ByteType, Type::NaturalType):
+				case compose(Type::ByteType, Type::IntegerType):
+					result = { .integer = (Int64)((Int64)(a.byte) - b.integer) };
+				return true;
+				case compose(Type::IntegerType, Type::CharacterType):
+				case compose(Type::NaturalType, Type::CharacterType):
+				case compose(Type::IntegerType, Type::ByteType):
+				case compose(Type::NaturalType, Type::ByteType):
+					result = { .integer = (Int64)(a.integer - (Int64)(b.byte)) };
+				return true;
+				case compose(Type::NaturalType, Type::NaturalType):
+				case compose(Type::IntegerType, Type::IntegerType):
+				case compose(Type::IntegerType, Type::NaturalType):
+				case compose(Type::NaturalType, Type::IntegerType):
+					result = { .integer = a.integer - b.integer };
+				return true;
+				case compose(Type::NaturalType, Type::RealType):
+					result = { .real = (UInt64)a.integer - b.real };
+				return true;
+				case compose(Type::IntegerType, Type::RealType):
+					result = { .real = a.integer - b.real };
+				return true;
+				case compose(Type::RealType, Type::NaturalType):
+					result = { .real = a.real - (UInt64)b.integer };
+				return true;
+				case compose(Type::RealType, Type::IntegerType):
+					result = { .real = a.real - b.integer };
+				return true;
+				case compose(Type::RealType, Type::RealType):
+				case compose(Type::ImaginaryType, Type::ImaginaryType):
+					result = { .real = a.real - b.real };
+				return true;
+				default: return false;
+			}
+		}
+
+		static inline Boolean multiply(Types types, Value a, Value b, Value & result) {
+			switch (types) {
+				case compose(Type::CharacterType, Type::CharacterType):
+				case compose(Type::CharacterType, Type::ByteType):
+				case compose(Type::ByteType, Type::CharacterType):
+				case compose(Type::ByteType, Type::ByteType):
+					result = { .integer = (Int64)((Int64)(a.byte) * (Int64)(b.byte)) };
+				return true;
+				case compose(Type::CharacterType, Type::NaturalType):
+				case compose(Type::ByteType, Type::NaturalType):
+					result = { .integer = (Int64)((UInt64)(a.byte) * (UInt64)b.integer) };
+				return true;
+				case compose(Type::CharacterType, Type::IntegerType):
+				case compose(Type::ByteType, Type::IntegerType):
+					result = { .integer = (Int64)((Int64)(a.byte) * b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::CharacterType):
+				case compose(Type::NaturalType, Type::ByteType):
+					result = { .integer = (Int64)((UInt64)a.integer * (UInt64)(b.byte)) };
+				return true;
+				case compose(Type::IntegerType, Type::CharacterType):
+				case compose(Type::IntegerType, Type::ByteType):
+					result = { .integer = (Int64)(a.integer * (Int64)(b.byte)) };
+				return true;
+				case compose(Type::NaturalType, Type::NaturalType):
+					result = { .integer = (Int64)((UInt64)a.integer * (UInt64)b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::IntegerType):
+					result = { .integer = (Int64)((UInt64)a.integer * b.integer) };
+				return true;
+				case compose(Type::IntegerType, Type::IntegerType):
+					result = { .integer = a.integer * b.integer };
+				return true;
+				case compose(Type::NaturalType, Type::RealType):
+				case compose(Type::NaturalType, Type::ImaginaryType):
+					result = { .real = (UInt64)a.integer * b.real };
+				return true;
+				case compose(Type::IntegerType, Type::RealType):
+				case compose(Type::IntegerType, Type::ImaginaryType):
+					result = { .real = a.integer * b.real };
+				return true;
+				case compose(Type::RealType, Type::NaturalType):
+					result = { .real = a.real * (UInt64)b.integer };
+				return true;
+				case compose(Type::RealType, Type::IntegerType):
+					result = { .real = a.real * b.integer };
+				return true;
+				case compose(Type::RealType, Type::RealType):
+				case compose(Type::RealType, Type::ImaginaryType):
+				case compose(Type::ImaginaryType, Type::ImaginaryType):
+					result = { .real = a.real * b.real };
+				return true;
+				case compose(Type::ImaginaryType, Type::NaturalType):
+					result = { .real = a.real * (UInt64)b.integer };
+				return true;
+				case compose(Type::ImaginaryType, Type::IntegerType):
+					result = { .real = a.real * b.integer };
+				return true;
+				case compose(Type::ImaginaryType, Type::RealType):
+					result = { .real = a.real * b.real };
+				return true;
+				default: return false;
+			}
+		}
+
+		template <typename Crash>
+		static inline Boolean divide(Types types, Value a, Value b, Value & result, Crash crash) {
+			switch (types) {
+				case compose(Type::CharacterType, Type::CharacterType):
+				case compose(Type::CharacterType, Type::ByteType):
+				case compose(Type::ByteType, Type::CharacterType):
+				case compose(Type::ByteType, Type::ByteType):
+					if (!b.byte) crash();
+					result = { .integer = (Int64)((Int64)(a.byte) / (Int64)(b.byte)) };
+				return true;
+				case compose(Type::CharacterType, Type::NaturalType):
+				case compose(Type::ByteType, Type::NaturalType):
+					if (!b.integer) crash();
+					result = { .integer = (Int64)((UInt64)(a.byte) / (UInt64)b.integer) };
+				return true;
+				case compose(Type::CharacterType, Type::IntegerType):
+				case compose(Type::ByteType, Type::IntegerType):
+					if (!b.integer) crash();
+					result = { .integer = (Int64)((Int64)(a.byte) / b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::CharacterType):
+				case compose(Type::NaturalType, Type::ByteType):
+					if (!b.byte) crash();
+					result = { .integer = (Int64)((UInt64)a.integer / (UInt64)(b.byte)) };
+				return true;
+				case compose(Type::IntegerType, Type::CharacterType):
+				case compose(Type::IntegerType, Type::ByteType):
+					if (!b.byte) crash();
+					result = { .integer = (Int64)(a.integer / (Int64)(b.byte)) };
+				return true;
+				case compose(Type::NaturalType, Type::NaturalType):
+					if (!b.integer) crash();
+					result = { .integer = (Int64)((UInt64)a.integer / (UInt64)b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::IntegerType):
+					if (!b.integer) crash();
+					result = { .integer = (Int64)((UInt64)a.integer / b.integer) };
+				return true;
+				case compose(Type::IntegerType, Type::IntegerType):
+					if (!b.integer) crash();
+					result = { .integer = a.integer / b.integer };
+				return true;
+				case compose(Type::NaturalType, Type::RealType):
+				case compose(Type::NaturalType, Type::ImaginaryType):
+					result = { .real = (Real)((UInt64)a.integer) / b.real };
+				return true;
+				case compose(Type::IntegerType, Type::RealType):
+				case compose(Type::IntegerType, Type::ImaginaryType):
+					result = { .real = (Real)(a.integer) / b.real };
+				return true;
+				case compose(Type::RealType, Type::NaturalType):
+					result = { .real = a.real / (Real)((UInt64)b.integer) };
+				return true;
+				case compose(Type::RealType, Type::IntegerType):
+					result = { .real = a.real / (Real)(b.integer) };
+				return true;
+				case compose(Type::RealType, Type::RealType):
+				case compose(Type::RealType, Type::ImaginaryType):
+				case compose(Type::ImaginaryType, Type::ImaginaryType):
+				case compose(Type::ImaginaryType, Type::RealType):
+					result = { .real = a.real / b.real };
+				return true;
+				case compose(Type::ImaginaryType, Type::NaturalType):
+					result = { .real = a.real / (Real)((UInt64)b.integer) };
+				return true;
+				case compose(Type::ImaginaryType, Type::IntegerType):
+					result = { .real = a.real / (Real)(b.integer) };
+				return true;
+				default: return false;
+			}
+		}
+
+		template <typename Crash>
+		static inline Boolean modulo(Types types, Value a, Value b, Value & result, Crash crash) {
+			switch (types) {
+				case compose(Type::CharacterType, Type::CharacterType):
+				case compose(Type::CharacterType, Type::ByteType):
+					if (!b.byte) crash();
+					result = { .integer = (Int64)((UInt64)(a.byte) % (UInt64)(b.byte)) };
+				return true;
+				case compose(Type::CharacterType, Type::NaturalType):
+					if (!b.integer) crash();
+					result = { .integer = (Int64)((UInt64)(a.byte) % (UInt64)b.integer) };
+				return true;
+				case compose(Type::CharacterType, Type::IntegerType):
+					if (!b.integer) crash();
+					result = { .integer = (Int64)((UInt64)(a.byte) % b.integer) };
+				return true;
+				case compose(Type::ByteType, Type::CharacterType):
+				case compose(Type::ByteType, Type::ByteType):
+					if (!b.byte) crash();
+					result = { .integer = (Int64)((UInt64)(a.byte) % (UInt64)(b.byte)) };
+				return true;
+				case compose(Type::ByteType, Type::NaturalType):
+					if (!b.integer) crash();
+					result = { .integer = (Int64)((UInt64)(a.byte) % (UInt64)b.integer) };
+				return true;
+				case compose(Type::ByteType, Type::IntegerType):
+					if (!b.integer) crash();
+					result = { .integer = (Int64)((UInt64)(a.byte) % b.integer) };
+				return true;
+				case compose(Type::IntegerType, Type::CharacterType):
+				case compose(Type::IntegerType, Type::ByteType):
+					if (!b.byte) crash();
+					result = { .integer = (Int64)(a.integer % (UInt64)(b.byte)) };
+				return true;
+				case compose(Type::IntegerType, Type::NaturalType):
+					if (!b.integer) crash();
+					result = { .integer = (Int64)(a.integer % (UInt64)b.integer) };
+				return true;
+				case compose(Type::IntegerType, Type::IntegerType):
+					if (!b.integer) crash();
+					result = { .integer = a.integer % b.integer };
+				return true;
+				case compose(Type::NaturalType, Type::CharacterType):
+				case compose(Type::NaturalType, Type::ByteType):
+					if (!b.byte) crash();
+					result = { .integer = (Int64)((UInt64)a.integer % (UInt64)(b.byte)) };
+				return true;
+				case compose(Type::NaturalType, Type::NaturalType):
+					if (!b.integer) crash();
+					result = { .integer = (Int64)((UInt64)a.integer % (UInt64)b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::IntegerType):
+					if (!b.integer) crash();
+					result = { .integer = (Int64)((UInt64)a.integer % b.integer) };
+				return true;
+				default: return false;
+			}
+		}
+
+		static inline Boolean equal(Types types, Value a, Value b, Value & result) {
+			switch (types) {
+				case compose(Type::BooleanType, Type::BooleanType):
+					result = { .boolean = (a.boolean == b.boolean) };
+				return true;
+				case compose(Type::CharacterType, Type::CharacterType):
+				case compose(Type::CharacterType, Type::ByteType):
+				case compose(Type::ByteType, Type::CharacterType):
+				case compose(Type::ByteType, Type::ByteType):
+					result = { .boolean = (a.byte == b.byte) };
+				return true;
+				case compose(Type::ByteType, Type::NaturalType):
+					result = { .boolean = (((UInt64)a.byte) == b.integer) };
+				return true;
+				case compose(Type::CharacterType, Type::IntegerType):
+				case compose(Type::ByteType, Type::IntegerType):
+					result = { .boolean = (((Int64)a.byte) == b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::ByteType):
+					result = { .boolean = (((UInt64)a.integer) == (UInt64)b.byte) };
+				return true;
+				case compose(Type::NaturalType, Type::NaturalType):
+					result = { .boolean = (((UInt64)a.integer) == (UInt64)b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::IntegerType):
+					result = { .boolean = (((UInt64)a.integer) == b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::RealType):
+					result = { .boolean = (((UInt64)a.integer) == b.real) };
+				return true;
+				case compose(Type::IntegerType, Type::CharacterType):
+				case compose(Type::IntegerType, Type::ByteType):
+					result = { .boolean = (a.integer == ((Int64)b.byte)) };
+				return true;
+				case compose(Type::IntegerType, Type::NaturalType):
+					result = { .boolean = (a.integer == (UInt64)b.integer) };
+				return true;
+				case compose(Type::IntegerType, Type::IntegerType):
+					result = { .boolean = (a.integer == b.integer) };
+				return true;
+				case compose(Type::IntegerType, Type::RealType):
+					result = { .boolean = (((Real)a.integer) == b.real) };
+				return true;
+				case compose(Type::RealType, Type::NaturalType):
+					result = { .boolean = (a.real == ((Real)((UInt64)b.integer))) };
+				return true;
+				case compose(Type::RealType, Type::IntegerType):
+					result = { .boolean = (a.real == ((Real)b.integer)) };
+				return true;
+				case compose(Type::RealType, Type::RealType):
+				case compose(Type::ImaginaryType, Type::ImaginaryType):
+					result = { .boolean = (a.real == b.real) };
+				return true;
+				default: return false;
+			}
+		}
+
+		static inline Boolean different(Types types, Value a, Value b, Value & result) {
+			switch (types) {
+				case compose(Type::BooleanType, Type::BooleanType):
+					result = { .boolean = (a.boolean != b.boolean) };
+				return true;
+				case compose(Type::CharacterType, Type::CharacterType):
+				case compose(Type::CharacterType, Type::ByteType):
+				case compose(Type::ByteType, Type::CharacterType):
+				case compose(Type::ByteType, Type::ByteType):
+					result = { .boolean = (a.byte != b.byte) };
+				return true;
+				case compose(Type::ByteType, Type::NaturalType):
+					result = { .boolean = (((UInt64)a.byte) != b.integer) };
+				return true;
+				case compose(Type::CharacterType, Type::IntegerType):
+				case compose(Type::ByteType, Type::IntegerType):
+					result = { .boolean = (((Int64)a.byte) != b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::ByteType):
+					result = { .boolean = (((UInt64)a.integer) != (UInt64)b.byte) };
+				return true;
+				case compose(Type::NaturalType, Type::NaturalType):
+					result = { .boolean = (((UInt64)a.integer) != (UInt64)b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::IntegerType):
+					result = { .boolean = (((UInt64)a.integer) != b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::RealType):
+					result = { .boolean = (((UInt64)a.integer) != b.real) };
+				return true;
+				case compose(Type::IntegerType, Type::CharacterType):
+				case compose(Type::IntegerType, Type::ByteType):
+					result = { .boolean = (a.integer != ((Int64)b.byte)) };
+				return true;
+				case compose(Type::IntegerType, Type::NaturalType):
+					result = { .boolean = (a.integer != (UInt64)b.integer) };
+				return true;
+				case compose(Type::IntegerType, Type::IntegerType):
+					result = { .boolean = (a.integer != b.integer) };
+				return true;
+				case compose(Type::IntegerType, Type::RealType):
+					result = { .boolean = (((Real)a.integer) != b.real) };
+				return true;
+				case compose(Type::RealType, Type::NaturalType):
+					result = { .boolean = (a.real != ((Real)((UInt64)b.integer))) };
+				return true;
+				case compose(Type::RealType, Type::IntegerType):
+					result = { .boolean = (a.real != ((Real)b.integer)) };
+				return true;
+				case compose(Type::RealType, Type::RealType):
+				case compose(Type::ImaginaryType, Type::ImaginaryType):
+					result = { .boolean = (a.real != b.real) };
+				return true;
+				default: return false;
+			}
+		}
+
+		static inline Boolean greater(Types types, Value a, Value b, Value & result) {
+			switch (types) {
+				case compose(Type::BooleanType, Type::BooleanType):
+					result = { .boolean = (a.boolean > b.boolean) };
+				return true;
+				case compose(Type::CharacterType, Type::CharacterType):
+				case compose(Type::CharacterType, Type::ByteType):
+				case compose(Type::ByteType, Type::CharacterType):
+				case compose(Type::ByteType, Type::ByteType):
+					result = { .boolean = (a.byte > b.byte) };
+				return true;
+				case compose(Type::ByteType, Type::NaturalType):
+					result = { .boolean = (((UInt64)a.byte) > b.integer) };
+				return true;
+				case compose(Type::CharacterType, Type::IntegerType):
+				case compose(Type::ByteType, Type::IntegerType):
+					result = { .boolean = (((Int64)a.byte) > b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::ByteType):
+					result = { .boolean = (((UInt64)a.integer) > (UInt64)b.byte) };
+				return true;
+				case compose(Type::NaturalType, Type::NaturalType):
+					result = { .boolean = (((UInt64)a.integer) > (UInt64)b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::IntegerType):
+					result = { .boolean = (a.integer > b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::RealType):
+					result = { .boolean = (((UInt64)a.integer) > b.real) };
+				return true;
+				case compose(Type::IntegerType, Type::CharacterType):
+				case compose(Type::IntegerType, Type::ByteType):
+					result = { .boolean = (a.integer > ((Int64)b.byte)) };
+				return true;
+				case compose(Type::IntegerType, Type::NaturalType):
+					result = { .boolean = (a.integer > b.integer) };
+				return true;
+				case compose(Type::IntegerType, Type::IntegerType):
+					result = { .boolean = (a.integer > b.integer) };
+				return true;
+				case compose(Type::IntegerType, Type::RealType):
+					result = { .boolean = (((Real)a.integer) > b.real) };
+				return true;
+				case compose(Type::RealType, Type::NaturalType):
+					result = { .boolean = (a.real > ((Real)((UInt64)b.integer))) };
+				return true;
+				case compose(Type::RealType, Type::IntegerType):
+					result = { .boolean = (a.real > ((Real)b.integer)) };
+				return true;
+				case compose(Type::RealType, Type::RealType):
+				case compose(Type::ImaginaryType, Type::ImaginaryType):
+					result = { .boolean = (a.real > b.real) };
+				return true;
+				default: return false;
+			}
+		}
+
+		static inline Boolean greaterEqual(Types types, Value a, Value b, Value & result) {
+			switch (types) {
+				case compose(Type::BooleanType, Type::BooleanType):
+					result = { .boolean = (a.boolean >= b.boolean) };
+				return true;
+				case compose(Type::CharacterType, Type::CharacterType):
+				case compose(Type::CharacterType, Type::ByteType):
+				case compose(Type::ByteType, Type::CharacterType):
+				case compose(Type::ByteType, Type::ByteType):
+					result = { .boolean = (a.byte >= b.byte) };
+				return true;
+				case compose(Type::ByteType, Type::NaturalType):
+					result = { .boolean = (((UInt64)a.byte) >= b.integer) };
+				return true;
+				case compose(Type::CharacterType, Type::IntegerType):
+				case compose(Type::ByteType, Type::IntegerType):
+					result = { .boolean = (((Int64)a.byte) >= b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::ByteType):
+					result = { .boolean = (((UInt64)a.integer) >= (UInt64)b.byte) };
+				return true;
+				case compose(Type::NaturalType, Type::NaturalType):
+					result = { .boolean = (((UInt64)a.integer) >= (UInt64)b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::IntegerType):
+					result = { .boolean = (a.integer >= b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::RealType):
+					result = { .boolean = (((UInt64)a.integer) >= b.real) };
+				return true;
+				case compose(Type::IntegerType, Type::CharacterType):
+				case compose(Type::IntegerType, Type::ByteType):
+					result = { .boolean = (a.integer >= ((Int64)b.byte)) };
+				return true;
+				case compose(Type::IntegerType, Type::NaturalType):
+					result = { .boolean = (a.integer >= b.integer) };
+				return true;
+				case compose(Type::IntegerType, Type::IntegerType):
+					result = { .boolean = (a.integer >= b.integer) };
+				return true;
+				case compose(Type::IntegerType, Type::RealType):
+					result = { .boolean = (((Real)a.integer) >= b.real) };
+				return true;
+				case compose(Type::RealType, Type::NaturalType):
+					result = { .boolean = (a.real >= ((Real)((UInt64)b.integer))) };
+				return true;
+				case compose(Type::RealType, Type::IntegerType):
+					result = { .boolean = (a.real >= ((Real)b.integer)) };
+				return true;
+				case compose(Type::RealType, Type::RealType):
+				case compose(Type::ImaginaryType, Type::ImaginaryType):
+					result = { .boolean = (a.real >= b.real) };
+				return true;
+				default: return false;
+			}
+		}
+
+		static inline Boolean less(Types types, Value a, Value b, Value & result) {
+			switch (types) {
+				case compose(Type::BooleanType, Type::BooleanType):
+					result = { .boolean = (a.boolean < b.boolean) };
+				return true;
+				case compose(Type::CharacterType, Type::CharacterType):
+				case compose(Type::CharacterType, Type::ByteType):
+				case compose(Type::ByteType, Type::CharacterType):
+				case compose(Type::ByteType, Type::ByteType):
+					result = { .boolean = (a.byte < b.byte) };
+				return true;
+				case compose(Type::ByteType, Type::NaturalType):
+					result = { .boolean = (((UInt64)a.byte) < b.integer) };
+				return true;
+				case compose(Type::CharacterType, Type::IntegerType):
+				case compose(Type::ByteType, Type::IntegerType):
+					result = { .boolean = (((Int64)a.byte) < b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::ByteType):
+					result = { .boolean = (((UInt64)a.integer) < (UInt64)b.byte) };
+				return true;
+				case compose(Type::NaturalType, Type::NaturalType):
+					result = { .boolean = (((UInt64)a.integer) < (UInt64)b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::IntegerType):
+					result = { .boolean = (a.integer < b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::RealType):
+					result = { .boolean = (((UInt64)a.integer) < b.real) };
+				return true;
+				case compose(Type::IntegerType, Type::CharacterType):
+				case compose(Type::IntegerType, Type::ByteType):
+					result = { .boolean = (a.integer < ((Int64)b.byte)) };
+				return true;
+				case compose(Type::IntegerType, Type::NaturalType):
+					result = { .boolean = (a.integer < b.integer) };
+				return true;
+				case compose(Type::IntegerType, Type::IntegerType):
+					result = { .boolean = (a.integer < b.integer) };
+				return true;
+				case compose(Type::IntegerType, Type::RealType):
+					result = { .boolean = (((Real)a.integer) < b.real) };
+				return true;
+				case compose(Type::RealType, Type::NaturalType):
+					result = { .boolean = (a.real < ((Real)((UInt64)b.integer))) };
+				return true;
+				case compose(Type::RealType, Type::IntegerType):
+					result = { .boolean = (a.real < ((Real)b.integer)) };
+				return true;
+				case compose(Type::RealType, Type::RealType):
+				case compose(Type::ImaginaryType, Type::ImaginaryType):
+					result = { .boolean = (a.real < b.real) };
+				return true;
+				default: return false;
+			}
+		}
+
+		static inline Boolean lessEqual(Types types, Value a, Value b, Value & result) {
+			switch (types) {
+				case compose(Type::BooleanType, Type::BooleanType):
+					result = { .boolean = (a.boolean <= b.boolean) };
+				return true;
+				case compose(Type::CharacterType, Type::CharacterType):
+				case compose(Type::CharacterType, Type::ByteType):
+				case compose(Type::ByteType, Type::CharacterType):
+				case compose(Type::ByteType, Type::ByteType):
+					result = { .boolean = (a.byte <= b.byte) };
+				return true;
+				case compose(Type::ByteType, Type::NaturalType):
+					result = { .boolean = (((UInt64)a.byte) <= b.integer) };
+				return true;
+				case compose(Type::CharacterType, Type::IntegerType):
+				case compose(Type::ByteType, Type::IntegerType):
+					result = { .boolean = (((Int64)a.byte) <= b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::ByteType):
+					result = { .boolean = (((UInt64)a.integer) <= (UInt64)b.byte) };
+				return true;
+				case compose(Type::NaturalType, Type::NaturalType):
+					result = { .boolean = (((UInt64)a.integer) <= (UInt64)b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::IntegerType):
+					result = { .boolean = (a.integer <= b.integer) };
+				return true;
+				case compose(Type::NaturalType, Type::RealType):
+					result = { .boolean = (((UInt64)a.integer) <= b.real) };
+				return true;
+				case compose(Type::IntegerType, Type::CharacterType):
+				case compose(Type::IntegerType, Type::ByteType):
+					result = { .boolean = (a.integer <= ((Int64)b.byte)) };
+				return true;
+				case compose(Type::IntegerType, Type::NaturalType):
+					result = { .boolean = (a.integer <= b.integer) };
+				return true;
+				case compose(Type::IntegerType, Type::IntegerType):
+					result = { .boolean = (a.integer <= b.integer) };
+				return true;
+				case compose(Type::IntegerType, Type::RealType):
+					result = { .boolean = (((Real)a.integer) <= b.real) };
+				return true;
+				case compose(Type::RealType, Type::NaturalType):
+					result = { .boolean = (a.real <= ((Real)((UInt64)b.integer))) };
+				return true;
+				case compose(Type::RealType, Type::IntegerType):
+					result = { .boolean = (a.real <= ((Real)b.integer)) };
+				return true;
+				case compose(Type::RealType, Type::RealType):
+				case compose(Type::ImaginaryType, Type::ImaginaryType):
+					result = { .boolean = (a.real <= b.real) };
+				return true;
+				default: return false;
+			}
+		}
+
+		static inline Boolean bitwiseAnd(Types types, Value a, Value b, Value & result) {
+			switch (types) {
+				case compose(Type::NaturalType, Type::NaturalType):
+				case compose(Type::IntegerType, Type::IntegerType):
+					result = { .integer = (Int64)((UInt64)a.integer & (UInt64)b.integer) };
+				return true;
+				case compose(Type::ByteType, Type::ByteType):
+				case compose(Type::CharacterType, Type::CharacterType):
+					result = { .byte = (Byte)(a.byte & b.byte) };
+				return true;
+				case compose(Type::BooleanType, Type::BooleanType):
+					result = { .boolean = a.boolean && b.boolean };
+				return true;
+				default: return false;
+			}
+		}
+
+		static inline Boolean bitwiseOr(Types types, Value a, Value b, Value & result) {
+			switch (types) {
+				case compose(Type::NaturalType, Type::NaturalType):
+				case compose(Type::IntegerType, Type::IntegerType):
+					result = { .integer = (Int64)((UInt64)a.integer | (UInt64)b.integer) };
+				return true;
+				case compose(Type::ByteType, Type::ByteType):
+				case compose(Type::CharacterType, Type::CharacterType):
+					result = { .byte = (Byte)(a.byte | b.byte) };
+				return true;
+				case compose(Type::BooleanType, Type::BooleanType):
+					result = { .boolean = a.boolean || b.boolean };
+				return true;
+				default: return false;
+			}
+		}
+
+		static inline Boolean bitwiseXor(Types types, Value a, Value b, Value & result) {
+			switch (types) {
+				case compose(Type::NaturalType, Type::NaturalType):
+				case compose(Type::IntegerType, Type::IntegerType):
+					result = { .integer = (Int64)((UInt64)a.integer ^ (UInt64)b.integer) };
+				return true;
+				case compose(Type::ByteType, Type::ByteType):
+				case compose(Type::CharacterType, Type::CharacterType):
+					result = { .byte = (Byte)(a.byte ^ b.byte) };
+				return true;
+				default: return false;
+			}
+		}
+
+		static inline Boolean shiftLeft(Type type, Value a, Value b, Value & result) {
+			switch (type) {
+				case Type::CharacterType:
+				case      Type::ByteType:
+					result = { .byte = (Byte)(a.byte << (SizeType)b.integer) };
+				return true;
+				case   Type::NaturalType:
+				case   Type::IntegerType:
+					result = { .integer = (a.integer << (SizeType)b.integer) };
+				return true;
+				default: return false;
+			}
+		}
+
+		static inline Boolean shiftRight(Type type, Value a, Value b, Value & result) {
+			switch (type) {
+				case Type::CharacterType:
+				case      Type::ByteType:
+					result = { .byte = (Byte)(a.byte >> (SizeType)b.integer) };
+				return true;
+				case   Type::NaturalType:
+				case   Type::IntegerType:
+					result = { .integer = (a.integer >> (SizeType)b.integer) };
+				return true;
+				default: return false;
+			}
+		}
+
+		static inline Boolean rotateLeft(Type type, Value a, Value b, Value & result) {
+			switch (type) {
+				case Type::CharacterType:
+				case      Type::ByteType:
+					result = { .byte = (Byte)(
+						a.byte << (SizeType)b.integer |
+						a.byte >> (8 - (SizeType)b.integer)
+					) };
+				return true;
+				case   Type::NaturalType:
+				case   Type::IntegerType:
+					result = { .integer = (
+						a.integer << (SizeType)b.integer |
+						a.integer >> (64 - (SizeType)b.integer)
+					) };
+				return true;
+				default: return false;
+			}
+		}
+
+		static inline Boolean rotateRight(Type type, Value a, Value b, Value & result) {
+			switch (type) {
+				case Type::CharacterType:
+				case      Type::ByteType:
+					result = { .byte = (Byte)(
+						a.byte >> (SizeType)b.integer |
+						a.byte << (8 - (SizeType)b.integer)
+					) };
+				return true;
+				case   Type::NaturalType:
+				case   Type::IntegerType:
+					result = { .integer = (
+						a.integer >> (SizeType)b.integer |
+						a.integer << (64 - (SizeType)b.integer)
+					) };
+				return true;
+				default: return false;
+			}
+		}
+
+		static inline Boolean negate(Type type, Value a, Value & result) {
+			switch (type) {
+				case Type::CharacterType:
+				case      Type::ByteType: result = { .integer = - a.byte }; return true;
+				case   Type::NaturalType:
+				case   Type::IntegerType: result = { .integer = - a.integer }; return true;
+				case      Type::RealType:
+				case Type::ImaginaryType: result = { .real = - a.real }; return true;
+				default: return false;
+			}
+		}
+
+		static inline Boolean invert(Type type, Value a, Value & result) {
+			switch (type) {
+				case    Type::ByteType: result = { .byte = (Byte)(~(a.byte)) }; return true;
+				case Type::NaturalType: result = { .integer = (Int64)(~((UInt64)a.integer)) }; return true;
+				case Type::IntegerType: result = { .integer = ~(a.integer) }; return true;
+				default: return false;
+			}
+		}
+
+		static inline Boolean cast(Types types, Value a, Value & result) {
+			switch (types) {
+				case compose(Type::CharacterType, Type::ByteType):
+				case compose(Type::ByteType, Type::CharacterType):
+					result = a; return true;
+				case compose(Type::CharacterType, Type::IntegerType):
+				case compose(Type::ByteType, Type::IntegerType):
+				case compose(Type::ByteType, Type::NaturalType):
+					result = { .integer = (Int64)a.byte };
+				return true;
+				case compose(Type::NaturalType, Type::ByteType):
+				case compose(Type::IntegerType, Type::CharacterType):
+				case compose(Type::IntegerType, Type::ByteType):
+					result = { .byte = (Byte)a.integer };
+				return true;
+				case compose(Type::NaturalType, Type::RealType):
+					result = { .real = (Real)((UInt64)a.integer) };
+				return true;
+				case compose(Type::IntegerType, Type::RealType):
+					result = { .real = (Real)a.integer };
+				return true;
+				case compose(Type::RealType, Type::NaturalType):
+					result = { .integer = (Int64)((UInt64)a.real) };
+				return true;
+				case compose(Type::RealType, Type::IntegerType):
+					result = { .integer = (Int64)a.real };
+				return true;
+				default: return false;
+			}
+		}
+
+		static inline Boolean print(Type type, Value value, Output & output) {
+			switch (type) {
+				// Basic Types:
+				case   Type::BooleanType: output.put(value.boolean ? "true" : "false", value.boolean ? 4 : 5); break;
+				case Type::CharacterType: output.put((Character)value.byte); break;
+				case      Type::ByteType: output.byte(value.byte); break;
+				case   Type::NaturalType: output.natural((UInt64)value.integer); break;
+				case   Type::IntegerType: output.integer(value.integer); break;
+				case      Type::RealType: output.put(Converter::realToString(value.real)); break;
+				case Type::ImaginaryType: output.put(Converter::imaginaryToString(value.real)); break;
+				// Basic Objects:
+				case   Type::ComplexType: output.put(((Complex *)value.pointer) -> toString()); break;
+				case    Type::StringType: output.put(*((String *)value.pointer)); break;
+				default: return false;
+			}
+			return true;
+		}
+
+	};
+
+}
+
+#endif
@@ -0,0 +1,69 @@
+
+/*!
+ *
+ *    + --------------------------------------- +
+ *    |  Output.cpp                             |
+ *    |                                         |
+ *    |             Buffered Output             |
+ *    |                                         |
+ *    |  Created by Cristian A.                 |
+ *    |  Copyright © MIT. All rights reserved.  |
+ *    + --------------------------------------- +
+ *
+ *    Note: This software is licensed under
+ *          the (MIT) Massachusetts Institute
+ *          of Technology License.
+ *
+!*/
+
+#include "Output.hpp"
+
+#ifndef SPIN_OUTPUT_CPP
+#define SPIN_OUTPUT_CPP
+
+#include <charconv>
+#include <iostream>
+
+#if __has_include(<unistd.h>)
+	#include <unistd.h>
+#endif
+
+namespace Spin {
+
+	Output::Output(std::ostream & stream, Boolean lined):
+		stream(& stream), lined(lined) { }
+	Output::~Output() { flush(); }
+
+	Boolean Output::terminal(std::ostream & stream) {
+		#if __has_include(<unistd.h>)
+		if (& stream == & std::cout) return isatty(STDOUT_FILENO);
+		if (& stream == & std::cerr) return isatty(STDERR_FILENO);
+		#endif
+		return false;
+	}
+
+	void Output::flush() {
+		if (size) stream -> write(buffer.data(), size);
+		stream -> flush();
+		size = 0;
+	}
+
+	void Output::natural(UInt64 value) {
+		Character digits[24];
+		auto end = std::to_chars(digits, digits + 24, value).ptr;
+		put(digits, end - digits);
+	}
+	void Output::integer(Int64 value) {
+		Character digits[24];
+		auto end = std::to_chars(digits, digits + 24, value).ptr;
+		put(digits, end - digits);
+	}
+	void Output::byte(UInt8 value) {
+		Character digits[2];
+		auto end = std::to_chars(digits, digits + 2, value, 16).ptr;
+		put(digits, end - digits);
+	}
+
+}
+
+#endif
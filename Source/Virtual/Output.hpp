@@ -0,0 +1,79 @@
+
+#include "../Common/Header.hpp"
+
+#ifndef SPIN_OUTPUT_HPP
+#define SPIN_OUTPUT_HPP
+
+#include <cstring>
+#include <ostream>
+
+namespace Spin {
+
+	// Buffer of the write and writeln interrupts: the
+	// bytes reach the stream only when it's full, at
+	// a flush (end of a run, read, sleep) or, when
+	// lined, at the end of every line. Numbers are
+	// written straight into the buffer, leaving the
+	// state of the stream (hexadecimal...) untouched.
+
+	class Output {
+
+		public:
+
+		static constexpr SizeType capacity = 1 << 16;
+
+		private:
+
+		std::ostream * stream = nullptr;
+		Array<Character> buffer = Array<Character>(capacity);
+		SizeType size = 0;
+
+		public:
+
+		// Flushes at every new line (terminals):
+		Boolean lined = false;
+
+		Output(std::ostream & stream, Boolean lined = false);
+		~Output();
+
+		Output(const Output &) = delete;
+		Output & operator = (const Output &) = delete;
+
+		// Whether the stream is a terminal:
+		static Boolean terminal(std::ostream & stream);
+
+		void flush();
+
+		inline void put(Character c) {
+			if (size == capacity) flush();
+			buffer[size++] = c;
+		}
+		inline void put(const Character * data, SizeType count) {
+			if (count > capacity - size) {
+				flush();
+				if (count >= capacity) {
+					stream -> write(data, count);
+					return;
+				}
+			}
+			std::memcpy(buffer.data() + size, data, count);
+			size += count;
+		}
+		inline void put(const String & string) {
+			put(string.data(), string.size());
+		}
+		inline void line() {
+			put('\n');
+			if (lined) flush();
+		}
+
+		void natural(UInt64 value);
+		void integer(Int64 value);
+		// Hexadecimal, lowercase and without padding:
+		void byte(UInt8 value);
+
+	};
+
+}
+
+#endif
@@ -25,9 +25,19 @@
 #include <random>
 #include <thread>
 
+#ifdef SPIN_GUARDED
+	#include <csetjmp>
+	#include <csignal>
+#endif
+
 #include "../Utility/Converter.hpp"
 #include "../Types/Complex.hpp"
 
+#include "Operations.hpp"
+#include "Encoding.hpp"
+#include "Counters.hpp"
+#include "Profiler.hpp"
+
 namespace Spin {
 
 	Processor::Crash::Crash(SizeType a, ByteCode b) {
@@ -40,1011 +50,824 @@ namespace Spin {
 		return address;
 	}
 
+	#ifdef SPIN_GUARDED
+
+	// Faults on the guard pages of the stacks of the
+	// Processor running on this thread jump back to
+	// its run, every other fault keeps its action.
+	// The jump skips destructors, so evaluate pushes
+	// nothing while an object that has one is alive:
+	struct Trap {
+		sigjmp_buf point;
+		const Guarded<Value> & values;
+		const Guarded<Frame> & frames;
+		Trap * previous;
+		Trap(const Guarded<Value> & values, const Guarded<Frame> & frames);
+		~Trap();
+	};
+
+	static thread_local Trap * trapped = nullptr;
+	// Actions before ours (SIGSEGV, SIGBUS):
+	static struct sigaction faults[2];
+
+	static void overflow(int signal, siginfo_t * info, void * context) {
+		if (trapped && (trapped -> values.guards(info -> si_addr) ||
+						trapped -> frames.guards(info -> si_addr))) {
+			siglongjmp(trapped -> point, 1);
+		}
+		// Every other fault goes to the previous action,
+		// ours stays for the next ones:
+		const struct sigaction & fault = faults[signal == SIGSEGV ? 0 : 1];
+		if (fault.sa_flags & SA_SIGINFO) {
+			fault.sa_sigaction(signal, info, context);
+		} else if (fault.sa_handler != SIG_DFL && fault.sa_handler != SIG_IGN) {
+			fault.sa_handler(signal);
+		} else {
+			// The default action ends the process:
+			struct sigaction action = {};
+			action.sa_handler = SIG_DFL;
+			sigemptyset(& action.sa_mask);
+			sigaction(signal, & action, nullptr);
+			raise(signal);
+		}
+	}
+	static Boolean install() {
+		struct sigaction action = {};
+		action.sa_sigaction = overflow;
+		action.sa_flags = SA_SIGINFO;
+		sigemptyset(& action.sa_mask);
+		sigaction(SIGSEGV, & action, & faults[0]);
+		sigaction(SIGBUS, & action, & faults[1]);
+		return true;
+	}
+
+	Trap::Trap(const Guarded<Value> & values, const Guarded<Frame> & frames):
+		values(values), frames(frames), previous(trapped) {
+		static const Boolean installed = install();
+		(void) installed;
+		trapped = this;
+	}
+	Trap::~Trap() { trapped = previous; }
+
+	#endif
+
+	Processor::Processor(std::ostream & output, std::istream & input):
+		engine(std::random_device()()),
+		output(output, Output::terminal(output)), input(& input) { }
+
 	const Real Processor::infinity = std::numeric_limits<double>::infinity();
 	const Real Processor::undefined = std::numeric_limits<double>::quiet_NaN();
 
-	Array<Pair<Pointer, Type>> Processor::objects;
+	#ifdef SPIN_TRACE
+		void (* Processor::tracer)(SizeType offset) = nullptr;
+		#define trace if (tracer) tracer(data - code)
+	#else
+		#define trace
+	#endif
 
-	Value Processor::evaluate(Program * program) {
-		if (!program) return { .integer = 0 };
-		// Random Device:
-		std::random_device device;
-		std::mt19937_64 engine(device());
+	#ifdef SPIN_COUNT
+		const Boolean Processor::counted = true;
+		#define tally if (counters) counters -> record(data)
+	#else
+		const Boolean Processor::counted = false;
+		#define tally
+	#endif
+
+	// Collects the objects that can't be reached from
+	// the stack, the temporary and the lamda address,
+	// and takes the samples of the Profiler:
+	#define safepoint if (collector.full()) { \
+		collector.collect(stack.data(), stack.data() + stack.size(), { c, l }); \
+	} \
+	if (profiler && profiler -> due()) { \
+		profiler -> sample(program, encoding, frames.data(), frames.size()); \
+	}
+
+	// Enters native code at the current instruction,
+	// counting hot entries (see Jit.hpp):
+	#define enter(counting) if (jit.enabled) { \
+		const Pointer entry = counting ? jit.hot(data - code) : jit.native(data - code); \
+		if (entry) data = code + jit.run(entry, stack, base); \
+	}
+
+	// Operands that unverified code could take out
+	// of the stack, or of the strings (see Verifier):
+	#define bounded(index, size) if (checked && (index) >= (size)) crash(data)
+
+	#ifdef SPIN_THREADED
+		const Boolean Processor::threaded = true;
+		// The case labels are only reached through the
+		// table, never by the switch:
+		#define handle(X) X##Handler: width = Encoding::lengths.of[OPCode::X]; [[fallthrough]]; case OPCode::X
+		#define dispatch trace; tally; goto * thread[* data]
+		#define next data += width; dispatch
+		#define jump dispatch
+	#else
+		const Boolean Processor::threaded = false;
+		#define handle(X) case OPCode::X
+		// The width is read next to the opcode:
+		#define next data += Encoding::lengths.of[* data]; continue
+		#define jump continue
+	#endif
+
+	template <Boolean checked>
+	Value Processor::evaluate(Program * program, const Encoding & encoding, Jit & jit) {
 		std::uniform_int_distribution<Int64> dist;
 		// Main:
-		Value a, b, c, l, s;
-		SizeType base = 0, ip = 0;
-		const SizeType count = program -> instructions.size();
-		while (ip < count) {
-			const ByteCode data = program -> instructions[ip];
-			switch (data.code) {
-				case OPCode::RST: break;
-				case OPCode::PSH:
-				case OPCode::TYP: stack.push(data.as.value); break;
-				case OPCode::STR:
-					stack.push({
-						.pointer = new String(program -> strings.at(
-							data.as.index
-						))
-					});
-				break;
-				case OPCode::LLA: l = stack.pop(); break;
-				case OPCode::ULA: stack.push(l); break;
-				case OPCode::LAM:
-					call.push(ip);
-					ip = (SizeType)(l.integer);
-					if (ip == 0) throw Crash(ip, data);
-				continue;
-				case OPCode::GET: stack.push(stack.at(data.as.index)); break;
-				case OPCode::SET: stack.edit(data.as.index, stack.top()); break;
-				case OPCode::SSF: frame.push(base); base = stack.size() - data.as.index; break;
-				case OPCode::GLF: stack.push(stack.at(base + data.as.index)); break;
-				case OPCode::SLF: stack.edit(base + data.as.index, stack.top()); break;
-				case OPCode::CTP: c = stack.pop(); break;
-				case OPCode::LTP: stack.push(c); break;
-				case OPCode::SWP:
+		Value a = { .integer = 0 }, b = a, c = a, l = a, s = a;
+		SizeType base = 0;
+		const UInt8 * code = encoding.code.data();
+		const UInt8 * last = code + encoding.code.size() - 1;
+		const UInt8 * data = code;
+		const Value * constants = encoding.constants.data();
+		collector.options = heap;
+		const auto crash = [&] (const UInt8 * at) {
+			const SizeType address = encoding.address(at - code);
+			throw Crash(address, program -> instructions[address]);
+		};
+		#ifdef SPIN_THREADED
+		// Each handler knows its own width, so that the
+		// next instruction doesn't wait for the opcode:
+		SizeType width = 0;
+		// Threaded Code:
+		static const Pointer handlers[] = {
+			&& RSTHandler, && PSHHandler, && STRHandler, && TYPHandler,
+			&& LLAHandler, && ULAHandler, && LAMHandler, && GETHandler,
+			&& SETHandler, && SSFHandler, && GLFHandler, && SLFHandler,
+			&& CTPHandler, && LTPHandler, && SWPHandler, && ADDHandler,
+			&& SUBHandler, && MULHandler, && DIVHandler, && MODHandler,
+			&& NEGHandler, && INVHandler, && SGSHandler, && SSSHandler,
+			&& AGSHandler, && ASSHandler, && SCNHandler, && ACNHandler,
+			&& CCJHandler, && VCJHandler, && MCJHandler, && PSTHandler,
+			&& PSFHandler, && PSIHandler, && PSUHandler, && PECHandler,
+			&& PESHandler, && PSAHandler, && PEAHandler, && POPHandler,
+			&& DHDHandler, && DSKHandler, && JMPHandler, && JIFHandler,
+			&& JAFHandler, && JITHandler, && JATHandler, && EQLHandler,
+			&& NEQHandler, && GRTHandler, && LSSHandler, && GEQHandler,
+			&& LEQHandler, && NOTHandler, && BWAHandler, && BWOHandler,
+			&& BWXHandler, && BSRHandler, && BSLHandler, && BRRHandler,
+			&& BRLHandler, && CALHandler, && CLLHandler, && RETHandler,
+			&& CSTHandler, && INTHandler, && HLTHandler, && ADIHandler,
+			&& SBIHandler, && MLIHandler, && DVIHandler, && MDIHandler,
+			&& ADRHandler, && SBRHandler, && MLRHandler, && DVRHandler,
+			&& EQIHandler, && NEIHandler, && GRIHandler, && LSIHandler,
+			&& GEIHandler, && LEIHandler, && EQRHandler, && NERHandler,
+			&& GRRHandler, && LSRHandler, && GERHandler, && LERHandler,
+			&& JEQHandler, && JNEHandler, && JGRHandler, && JLSHandler,
+			&& JGEHandler, && JLEHandler, && SEPHandler, && SFPHandler,
+			&& GTTHandler, && GFTHandler, && GTCHandler, && GFCHandler,
+			&& ADGHandler, && ADFHandler, && ICGHandler, && ICFHandler,
+			&& TCLHandler,
+		};
+		static_assert(
+			sizeof(handlers) / sizeof(Pointer) == OPCode::TLT,
+			"Every opcode needs its own threaded handler!"
+		);
+		// Each handler jumps straight to the next one
+		// through the table of the opcodes, without the
+		// switch and its bounds check. The end of the
+		// code closes the program when it doesn't end
+		// with HLT:
+		Pointer thread[256];
+		for (SizeType i = 0; i < 256; i += 1) {
+			if (i >= OPCode::TLT) thread[i] = && crashHandler;
+			else thread[i] = handlers[i];
+		}
+		thread[Encoding::end] = && endHandler;
+		enter(true);
+		dispatch;
+		#else
+		enter(true);
+		#endif
+		while (data < last) {
+			trace; tally;
+			switch (* data) {
+				handle(RST): next;
+				handle(PSH): stack.push(constants[Encoding::readIndex(data)]); next;
+				handle(TYP): stack.push({ .integer = Encoding::readType(data) }); next;
+				handle(STR): {
+					// Shared literals live in the program, out of
+					// the reach of the collector:
+					const SizeType index = Encoding::readIndex(data);
+					bounded(index & ~Encoding::shared, program -> strings.size());
+					if (index & Encoding::shared) {
+						stack.push({ .pointer = & program -> strings[index ^ Encoding::shared] });
+					} else {
+						stack.push({ .pointer = collector.string(program -> strings[index]) });
+					}
+				} next;
+				handle(LLA): l = stack.pop(); next;
+				handle(ULA): stack.push(l); next;
+				handle(LAM):
+					if (l.integer == 0) {
+						throw Crash(0, program -> instructions[encoding.address(data - code)]);
+					}
+					if ((SizeType)l.integer >= encoding.offsets.size()) crash(data);
+					frames.peek().address = (data - code) + Encoding::lengths.of[OPCode::LAM];
+					data = code + encoding.offsets[(SizeType)l.integer];
+					frames.peek().routine = data - code;
+					safepoint;
+					enter(true);
+				jump;
+				handle(GET):
+					bounded(Encoding::readIndex(data), stack.size());
+					stack.push(stack.at(Encoding::readIndex(data)));
+				next;
+				handle(SET):
+					bounded(Encoding::readIndex(data), stack.size());
+					stack.edit(Encoding::readIndex(data), stack.top());
+				next;
+				handle(SSF):
+					bounded(Encoding::readIndex(data), stack.size() + 1);
+					frames.push({ .base = base });
+					base = stack.size() - Encoding::readIndex(data);
+				next;
+				handle(GLF):
+					bounded(base + Encoding::readIndex(data), stack.size());
+					stack.push(stack.at(base + Encoding::readIndex(data)));
+				next;
+				handle(SLF):
+					bounded(base + Encoding::readIndex(data), stack.size());
+					stack.edit(base + Encoding::readIndex(data), stack.top());
+				next;
+				handle(CTP): c = stack.pop(); next;
+				handle(LTP): stack.push(c); next;
+				handle(SWP):
 					b = stack.pop();
 					a = stack.pop();
+					// Computed slots, checked even when verified:
+					if ((SizeType)a.integer >= stack.size() ||
+						(SizeType)b.integer >= stack.size()) crash(data);
 					stack.push(stack.at((SizeType)a.integer));
 					stack.push(stack.at((SizeType)b.integer));
 					stack.edit((SizeType)a.integer, stack.pop());
 					stack.edit((SizeType)b.integer, stack.pop());
-				break;
-				case OPCode::ADD:
+				next;
+				handle(ADD):
 					b = stack.pop();
-					a = stack.pop();
-					switch (data.as.types) {
-						// Basic Types:
-						case compose(Type::CharacterType, Type::CharacterType):
-						case compose(Type::CharacterType, Type::ByteType):
-						case compose(Type::ByteType, Type::CharacterType):
-						case compose(Type::ByteType, Type::ByteType):
-							stack.push({ .integer = (Int64)((Int64)(a.byte) + (Int64)(b.byte)) });
-						break;
-						case compose(Type::CharacterType, Type::IntegerType):
-						case compose(Type::CharacterType, Type::NaturalType):
-						case compose(Type::ByteType, Type::IntegerType):
-						case compose(Type::ByteType, Type::NaturalType):
-							stack.push({ .integer = (Int64)((Int64)(a.byte) + b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::CharacterType):
-						case compose(Type::IntegerType, Type::CharacterType):
-						case compose(Type::NaturalType, Type::ByteType):
-						case compose(Type::IntegerType, Type::ByteType):
-							stack.push({ .integer = (Int64)(a.integer + (Int64)(b.byte)) });
-						break;
-						case compose(Type::NaturalType, Type::NaturalType):
-						case compose(Type::IntegerType, Type::IntegerType):
-						case compose(Type::IntegerType, Type::NaturalType):
-						case compose(Type::NaturalType, Type::IntegerType):
-							stack.push({ .integer = a.integer + b.integer });
-						break;
-						case compose(Type::NaturalType, Type::RealType):
-							stack.push({ .real = ((UInt64)a.integer) + b.real });
-						break;
-						case compose(Type::IntegerType, Type::RealType):
-							stack.push({ .real = a.integer + b.real });
-						break;
-						case compose(Type::RealType, Type::NaturalType):
-							stack.push({ .real = a.real + ((UInt64)b.integer) });
-						break;
-						case compose(Type::RealType, Type::IntegerType):
-							stack.push({ .real = a.real + b.integer });
-						break;
-						case compose(Type::RealType, Type::RealType):
-						case compose(Type::ImaginaryType, Type::ImaginaryType):
-							stack.push({ .real = a.real + b.real });
-						break;
+					a = stack.top();
+					if (Operations::add(Encoding::readTypes(data), a, b, s)) {
+						stack.peek() = s; next;
+					}
+					stack.decrease();
+					switch (Encoding::readTypes(data)) {
 						// Basic Objects:
 						case compose(Type::NaturalType, Type::ImaginaryType): {
-							Complex * complex = new Complex((Real)((UInt64)a.integer), b.real);
-							objects.push_back({ complex, Type::ComplexType });
+							Complex * complex = collector.complex((Real)((UInt64)a.integer), b.real);
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::NaturalType, Type::ComplexType): {
 							Complex * complex = (Complex *)b.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a) + (Real)((UInt64)a.integer),
 								(complex -> b)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::IntegerType, Type::ImaginaryType): {
-							Complex * complex = new Complex((Real)a.integer, b.real);
-							objects.push_back({ complex, Type::ComplexType });
+							Complex * complex = collector.complex((Real)a.integer, b.real);
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::IntegerType, Type::ComplexType): {
 							Complex * complex = (Complex *)b.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a) + (Real)a.integer,
 								(complex -> b)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::RealType, Type::ImaginaryType): {
-							Complex * complex = new Complex(a.real, b.real);
-							objects.push_back({ complex, Type::ComplexType });
+							Complex * complex = collector.complex(a.real, b.real);
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::RealType, Type::ComplexType): {
 							Complex * complex = (Complex *)b.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a) + a.real,
 								(complex -> b)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ImaginaryType, Type::NaturalType): {
-							Complex * complex = new Complex((Real)((UInt64)b.integer), a.real);
-							objects.push_back({ complex, Type::ComplexType });
+							Complex * complex = collector.complex((Real)((UInt64)b.integer), a.real);
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ImaginaryType, Type::IntegerType): {
-							Complex * complex = new Complex((Real)b.integer, a.real);
-							objects.push_back({ complex, Type::ComplexType });
+							Complex * complex = collector.complex((Real)b.integer, a.real);
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ImaginaryType, Type::RealType): {
-							Complex * complex = new Complex(b.real, a.real);
-							objects.push_back({ complex, Type::ComplexType });
+							Complex * complex = collector.complex(b.real, a.real);
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ImaginaryType, Type::ComplexType): {
 							Complex * complex = (Complex *)b.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a),
 								(complex -> b) + a.real
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::NaturalType): {
 							Complex * complex = (Complex *)a.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a) + (Real)((UInt64)b.integer),
 								(complex -> b)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::IntegerType): {
 							Complex * complex = (Complex *)a.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a) + (Real)b.integer,
 								(complex -> b)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::RealType): {
 							Complex * complex = (Complex *)a.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a) + b.real,
 								(complex -> b)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::ImaginaryType): {
 							Complex * complex = (Complex *)a.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a),
 								(complex -> b) + b.real
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::ComplexType): {
-							Complex * complex = new Complex(
+							Complex * complex = collector.complex(
 								*((Complex *)a.pointer) +
 								*((Complex *)b.pointer)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::StringType, Type::CharacterType): {
-							String * string = new String(*((String *)(a.pointer)));
+							String * string = collector.string(*((String *)(a.pointer)));
 							string -> push_back((Character)b.byte);
-							objects.push_back({ string, Type::StringType });
 							stack.push({ .pointer = string });
 						} break;
 						case compose(Type::CharacterType, Type::StringType): {
-							String * string = new String(
+							String * string = collector.string(
 								((Character)a.byte) +
 								(*((String *)(b.pointer)))
 							);
-							objects.push_back({ string, Type::StringType });
 							stack.push({ .pointer = string });
 						} break;
 						case compose(Type::StringType, Type::StringType): {
-							String * string = new String(
+							String * string = collector.string(
 								(*((String *)(a.pointer))) +
 								(*((String *)(b.pointer)))
 							);
-							objects.push_back({ string, Type::StringType });
 							stack.push({ .pointer = string });
 						} break;
 						default: return { .integer = 0 };
 					}
-				break;
-				case OPCode::SUB:
+				next;
+				handle(SUB):
 					b = stack.pop();
-					a = stack.pop();
-					switch (data.as.types) {
-						// Basic Types:
-						case compose(Type::CharacterType, Type::CharacterType):
-						case compose(Type::CharacterType, Type::ByteType):
-						case compose(Type::ByteType, Type::CharacterType):
-						case compose(Type::ByteType, Type::ByteType):
-							stack.push({ .integer = (Int64)((Int64)(a.byte) - (Int64)(b.byte)) });
-						break;
-						case compose(Type::CharacterType, Type::NaturalType):
-						case compose(Type::CharacterType, Type::IntegerType):
-						case compose(Type::ByteType, Type::NaturalType):
-						case compose(Type::ByteType, Type::IntegerType):
-							stack.push({ .integer = (Int64)((Int64)(a.byte) - b.integer) });
-						break;
-						case compose(Type::IntegerType, Type::CharacterType):
-						case compose(Type::NaturalType, Type::CharacterType):
-						case compose(Type::IntegerType, Type::ByteType):
-						case compose(Type::NaturalType, Type::ByteType):
-							stack.push({ .integer = (Int64)(a.integer - (Int64)(b.byte)) });
-						break;
-						case compose(Type::NaturalType, Type::NaturalType):
-						case compose(Type::IntegerType, Type::IntegerType):
-						case compose(Type::IntegerType, Type::NaturalType):
-						case compose(Type::NaturalType, Type::IntegerType):
-							stack.push({ .integer = a.integer - b.integer });
-						break;
-						case compose(Type::NaturalType, Type::RealType):
-							stack.push({ .real = (UInt64)a.integer - b.real });
-						break;
-						case compose(Type::IntegerType, Type::RealType):
-							stack.push({ .real = a.integer - b.real });
-						break;
-						case compose(Type::RealType, Type::NaturalType):
-							stack.push({ .real = a.real - (UInt64)b.integer });
-						break;
-						case compose(Type::RealType, Type::IntegerType):
-							stack.push({ .real = a.real - b.integer });
-						break;
-						case compose(Type::RealType, Type::RealType):
-						case compose(Type::ImaginaryType, Type::ImaginaryType):
-							stack.push({ .real = a.real - b.real });
-						break;
+					a = stack.top();
+					if (Operations::subtract(Encoding::readTypes(data), a, b, s)) {
+						stack.peek() = s; next;
+					}
+					stack.decrease();
+					switch (Encoding::readTypes(data)) {
 						// Basic Objects:
 						case compose(Type::NaturalType, Type::ImaginaryType): {
-							Complex * complex = new Complex((Real)((UInt64)a.integer), - b.real);
-							objects.push_back({ complex, Type::ComplexType });
+							Complex * complex = collector.complex((Real)((UInt64)a.integer), - b.real);
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::NaturalType, Type::ComplexType): {
 							Complex * complex = (Complex *)b.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(Real)((UInt64)a.integer) - (complex -> a),
 								- (complex -> b)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::IntegerType, Type::ImaginaryType): {
-							Complex * complex = new Complex((Real)a.integer, - b.real);
-							objects.push_back({ complex, Type::ComplexType });
+							Complex * complex = collector.complex((Real)a.integer, - b.real);
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::IntegerType, Type::ComplexType): {
 							Complex * complex = (Complex *)b.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(Real)a.integer - (complex -> a),
 								- (complex -> b)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::RealType, Type::ImaginaryType): {
-							Complex * complex = new Complex(a.real, - b.real);
-							objects.push_back({ complex, Type::ComplexType });
+							Complex * complex = collector.complex(a.real, - b.real);
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::RealType, Type::ComplexType): {
 							Complex * complex = (Complex *)b.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								a.real - (complex -> a),
 								- (complex -> b)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ImaginaryType, Type::NaturalType): {
-							Complex * complex = new Complex(-((Real)((UInt64)b.integer)), a.real);
-							objects.push_back({ complex, Type::ComplexType });
+							Complex * complex = collector.complex(-((Real)((UInt64)b.integer)), a.real);
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ImaginaryType, Type::IntegerType): {
-							Complex * complex = new Complex(-((Real)b.integer), a.real);
-							objects.push_back({ complex, Type::ComplexType });
+							Complex * complex = collector.complex(-((Real)b.integer), a.real);
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ImaginaryType, Type::RealType): {
-							Complex * complex = new Complex(- b.real, a.real);
-							objects.push_back({ complex, Type::ComplexType });
+							Complex * complex = collector.complex(- b.real, a.real);
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ImaginaryType, Type::ComplexType): {
 							Complex * complex = (Complex *)b.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								- (complex -> a),
 								a.real - (complex -> b)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::NaturalType): {
 							Complex * complex = (Complex *)a.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a) - (Real)((UInt64)b.integer),
 								(complex -> b)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::IntegerType): {
 							Complex * complex = (Complex *)a.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a) - (Real)b.integer,
 								(complex -> b)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::RealType): {
 							Complex * complex = (Complex *)a.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a) - b.real,
 								(complex -> b)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::ImaginaryType): {
 							Complex * complex = (Complex *)a.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a),
 								(complex -> b) - b.real
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::ComplexType): {
-							Complex * complex = new Complex(
+							Complex * complex = collector.complex(
 								*((Complex *)a.pointer) -
 								*((Complex *)b.pointer)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						default: return { .integer = 0 };
 					}
-				break;
-				case OPCode::MUL:
+				next;
+				handle(MUL):
 					b = stack.pop();
-					a = stack.pop();
-					switch (data.as.types) {
-						// Basic Types:
-						case compose(Type::CharacterType, Type::CharacterType):
-						case compose(Type::CharacterType, Type::ByteType):
-						case compose(Type::ByteType, Type::CharacterType):
-						case compose(Type::ByteType, Type::ByteType):
-							stack.push({ .integer = (Int64)((Int64)(a.byte) * (Int64)(b.byte)) });
-						break;
-						case compose(Type::CharacterType, Type::NaturalType):
-						case compose(Type::ByteType, Type::NaturalType):
-							stack.push({ .integer = (Int64)((UInt64)(a.byte) * (UInt64)b.integer) });
-						break;
-						case compose(Type::CharacterType, Type::IntegerType):
-						case compose(Type::ByteType, Type::IntegerType):
-							stack.push({ .integer = (Int64)((Int64)(a.byte) * b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::CharacterType):
-						case compose(Type::NaturalType, Type::ByteType):
-							stack.push({ .integer = (Int64)((UInt64)a.integer * (UInt64)(b.byte)) });
-						break;
-						case compose(Type::IntegerType, Type::CharacterType):
-						case compose(Type::IntegerType, Type::ByteType):
-							stack.push({ .integer = (Int64)(a.integer * (Int64)(b.byte)) });
-						break;
-						case compose(Type::NaturalType, Type::NaturalType):
-							stack.push({ .integer = (Int64)((UInt64)a.integer * (UInt64)b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::IntegerType):
-							stack.push({ .integer = (Int64)((UInt64)a.integer * b.integer) });
-						break;
-						case compose(Type::IntegerType, Type::IntegerType):
-							stack.push({ .integer = a.integer * b.integer });
-						break;
-						case compose(Type::NaturalType, Type::RealType):
-						case compose(Type::NaturalType, Type::ImaginaryType):
-							stack.push({ .real = (UInt64)a.integer * b.real });
-						break;
-						case compose(Type::IntegerType, Type::RealType):
-						case compose(Type::IntegerType, Type::ImaginaryType):
-							stack.push({ .real = a.integer * b.real });
-						break;
-						case compose(Type::RealType, Type::NaturalType):
-							stack.push({ .real = a.real * (UInt64)b.integer });
-						break;
-						case compose(Type::RealType, Type::IntegerType):
-							stack.push({ .real = a.real * b.integer });
-						break;
-						case compose(Type::RealType, Type::RealType):
-						case compose(Type::RealType, Type::ImaginaryType):
-						case compose(Type::ImaginaryType, Type::ImaginaryType):
-							stack.push({ .real = a.real * b.real });
-						break;
-						case compose(Type::ImaginaryType, Type::NaturalType):
-							stack.push({ .real = a.real * (UInt64)b.integer });
-						break;
-						case compose(Type::ImaginaryType, Type::IntegerType):
-							stack.push({ .real = a.real * b.integer });
-						break;
-						case compose(Type::ImaginaryType, Type::RealType):
-							stack.push({ .real = a.real * b.real });
-						break;
+					a = stack.top();
+					if (Operations::multiply(Encoding::readTypes(data), a, b, s)) {
+						stack.peek() = s; next;
+					}
+					stack.decrease();
+					switch (Encoding::readTypes(data)) {
 						// Basic Objects:
 						case compose(Type::NaturalType, Type::ComplexType): {
 							Complex * complex = (Complex *)b.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a) * (Real)((UInt64)a.integer),
 								(complex -> b) * (Real)((UInt64)a.integer)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::IntegerType, Type::ComplexType): {
 							Complex * complex = (Complex *)b.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a) * (Real)a.integer,
 								(complex -> b) * (Real)a.integer
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::RealType, Type::ComplexType): {
 							Complex * complex = (Complex *)b.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a) * a.real,
 								(complex -> b) * a.real
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ImaginaryType, Type::ComplexType): {
 							Complex * complex = (Complex *)b.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								- ((complex -> b) * a.real),
 								(complex -> a) * a.real
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::NaturalType): {
 							Complex * complex = (Complex *)a.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a) * (Real)((UInt64)b.integer),
 								(complex -> b) * (Real)((UInt64)b.integer)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::IntegerType): {
 							Complex * complex = (Complex *)a.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a) * (Real)b.integer,
 								(complex -> b) * (Real)b.integer
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::RealType): {
 							Complex * complex = (Complex *)a.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a) * b.real,
 								(complex -> b) * b.real
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::ImaginaryType): {
 							Complex * complex = (Complex *)a.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								- ((complex -> b) * b.real),
 								(complex -> a) * b.real
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::ComplexType): {
-							Complex * complex = new Complex(
+							Complex * complex = collector.complex(
 								*((Complex *)a.pointer) *
 								*((Complex *)b.pointer)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						default: return { .integer = 0 };
 					}
-				break;
-				case OPCode::DIV:
+				next;
+				handle(DIV):
 					b = stack.pop();
-					a = stack.pop();
-					switch (data.as.types) {
-						// Basic Types:
-						case compose(Type::CharacterType, Type::CharacterType):
-						case compose(Type::CharacterType, Type::ByteType):
-						case compose(Type::ByteType, Type::CharacterType):
-						case compose(Type::ByteType, Type::ByteType):
-							if (!b.byte) throw Crash(ip, data);
-							stack.push({ .integer = (Int64)((Int64)(a.byte) / (Int64)(b.byte)) });
-						break;
-						case compose(Type::CharacterType, Type::NaturalType):
-						case compose(Type::ByteType, Type::NaturalType):
-							if (!b.integer) throw Crash(ip, data);
-							stack.push({ .integer = (Int64)((UInt64)(a.byte) / (UInt64)b.integer) });
-						break;
-						case compose(Type::CharacterType, Type::IntegerType):
-						case compose(Type::ByteType, Type::IntegerType):
-							if (!b.integer) throw Crash(ip, data);
-							stack.push({ .integer = (Int64)((Int64)(a.byte) / b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::CharacterType):
-						case compose(Type::NaturalType, Type::ByteType):
-							if (!b.byte) throw Crash(ip, data);
-							stack.push({ .integer = (Int64)((UInt64)a.integer / (UInt64)(b.byte)) });
-						break;
-						case compose(Type::IntegerType, Type::CharacterType):
-						case compose(Type::IntegerType, Type::ByteType):
-							if (!b.byte) throw Crash(ip, data);
-							stack.push({ .integer = (Int64)(a.integer / (Int64)(b.byte)) });
-						break;
-						case compose(Type::NaturalType, Type::NaturalType):
-							if (!b.integer) throw Crash(ip, data);
-							stack.push({ .integer = (Int64)((UInt64)a.integer / (UInt64)b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::IntegerType):
-							if (!b.integer) throw Crash(ip, data);
-							stack.push({ .integer = (Int64)((UInt64)a.integer / b.integer) });
-						break;
-						case compose(Type::IntegerType, Type::IntegerType):
-							if (!b.integer) throw Crash(ip, data);
-							stack.push({ .integer = a.integer / b.integer });
-						break;
-						case compose(Type::NaturalType, Type::RealType):
-						case compose(Type::NaturalType, Type::ImaginaryType):
-							stack.push({ .real = (Real)((UInt64)a.integer) / b.real });
-						break;
-						case compose(Type::IntegerType, Type::RealType):
-						case compose(Type::IntegerType, Type::ImaginaryType):
-							stack.push({ .real = (Real)(a.integer) / b.real });
-						break;
-						case compose(Type::RealType, Type::NaturalType):
-							stack.push({ .real = a.real / (Real)((UInt64)b.integer) });
-						break;
-						case compose(Type::RealType, Type::IntegerType):
-							stack.push({ .real = a.real / (Real)(b.integer) });
-						break;
-						case compose(Type::RealType, Type::RealType):
-						case compose(Type::RealType, Type::ImaginaryType):
-						case compose(Type::ImaginaryType, Type::ImaginaryType):
-						case compose(Type::ImaginaryType, Type::RealType):
-							stack.push({ .real = a.real / b.real });
-						break;
-						case compose(Type::ImaginaryType, Type::NaturalType):
-							stack.push({ .real = a.real / (Real)((UInt64)b.integer) });
-						break;
-						case compose(Type::ImaginaryType, Type::IntegerType):
-							stack.push({ .real = a.real / (Real)(b.integer) });
-						break;
+					a = stack.top();
+					if (Operations::divide(Encoding::readTypes(data), a, b, s, [&] { crash(data); })) {
+						stack.peek() = s; next;
+					}
+					stack.decrease();
+					switch (Encoding::readTypes(data)) {
 						// Basic Objects:
 						case compose(Type::NaturalType, Type::ComplexType): {
 							Complex * complex = (Complex *)b.pointer;
 							a.real = ((Real)(UInt64)a.integer) / (complex -> getNormalised());
-							complex = new Complex(
+							complex = collector.complex(
 								a.real * (complex -> a),
 								a.real * (- (complex -> b))
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::IntegerType, Type::ComplexType): {
 							Complex * complex = (Complex *)b.pointer;
 							a.real = ((Real)a.integer) / (complex -> getNormalised());
-							complex = new Complex(
+							complex = collector.complex(
 								a.real * (complex -> a),
 								a.real * (- (complex -> b))
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::RealType, Type::ComplexType): {
 							Complex * complex = (Complex *)b.pointer;
 							a.real /= (complex -> getNormalised());
-							complex = new Complex(
+							complex = collector.complex(
 								a.real * (complex -> a),
 								a.real * (- (complex -> b))
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ImaginaryType, Type::ComplexType): {
 							Complex * complex = (Complex *)b.pointer;
 							a.real /= (complex -> getNormalised());
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> b) * a.real,
 								(complex -> a) * a.real
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::NaturalType): {
 							Complex * complex = (Complex *)a.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a) / (Real)((UInt64)b.integer),
 								(complex -> b) / (Real)((UInt64)b.integer)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::IntegerType): {
 							Complex * complex = (Complex *)a.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a) / (Real)b.integer,
 								(complex -> b) / (Real)b.integer
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::RealType): {
 							Complex * complex = (Complex *)a.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> a) / b.real,
 								(complex -> b) / b.real
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::ImaginaryType): {
 							Complex * complex = (Complex *)a.pointer;
-							complex = new Complex(
+							complex = collector.complex(
 								(complex -> b) / b.real,
 								- ((complex -> a) / b.real)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::ComplexType): {
-							Complex * complex = new Complex(
+							Complex * complex = collector.complex(
 								*((Complex *)a.pointer) /
 								*((Complex *)b.pointer)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						default: return { .integer = 0 };
 					}
-				break;
-				case OPCode::MOD:
+				next;
+				handle(MOD):
 					b = stack.pop();
-					a = stack.pop();
-					switch (data.as.types) {
-						case compose(Type::CharacterType, Type::CharacterType):
-						case compose(Type::CharacterType, Type::ByteType):
-							if (!b.byte) throw Crash(ip, data);
-							stack.push({ .integer = (Int64)((UInt64)(a.byte) % (UInt64)(b.byte)) });
-						break;
-						case compose(Type::CharacterType, Type::NaturalType):
-							if (!b.integer) throw Crash(ip, data);
-							stack.push({ .integer = (Int64)((UInt64)(a.byte) % (UInt64)b.integer) });
-						break;
-						case compose(Type::CharacterType, Type::IntegerType):
-							if (!b.integer) throw Crash(ip, data);
-							stack.push({ .integer = (Int64)((UInt64)(a.byte) % b.integer) });
-						break;
-						case compose(Type::ByteType, Type::CharacterType):
-						case compose(Type::ByteType, Type::ByteType):
-							if (!b.byte) throw Crash(ip, data);
-							stack.push({ .integer = (Int64)((UInt64)(a.byte) % (UInt64)(b.byte)) });
-						break;
-						case compose(Type::ByteType, Type::NaturalType):
-							if (!b.integer) throw Crash(ip, data);
-							stack.push({ .integer = (Int64)((UInt64)(a.byte) % (UInt64)b.integer) });
-						break;
-						case compose(Type::ByteType, Type::IntegerType):
-							if (!b.integer) throw Crash(ip, data);
-							stack.push({ .integer = (Int64)((UInt64)(a.byte) % b.integer) });
-						break;
-						case compose(Type::IntegerType, Type::CharacterType):
-						case compose(Type::IntegerType, Type::ByteType):
-							if (!b.byte) throw Crash(ip, data);
-							stack.push({ .integer = (Int64)(a.integer % (UInt64)(b.byte)) });
-						break;
-						case compose(Type::IntegerType, Type::NaturalType):
-							if (!b.integer) throw Crash(ip, data);
-							stack.push({ .integer = (Int64)(a.integer % (UInt64)b.integer) });
-						break;
-						case compose(Type::IntegerType, Type::IntegerType):
-							if (!b.integer) throw Crash(ip, data);
-							stack.push({ .integer = a.integer % b.integer });
-						break;
-						case compose(Type::NaturalType, Type::CharacterType):
-						case compose(Type::NaturalType, Type::ByteType):
-							if (!b.byte) throw Crash(ip, data);
-							stack.push({ .integer = (Int64)((UInt64)a.integer % (UInt64)(b.byte)) });
-						break;
-						case compose(Type::NaturalType, Type::NaturalType):
-							if (!b.integer) throw Crash(ip, data);
-							stack.push({ .integer = (Int64)((UInt64)a.integer % (UInt64)b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::IntegerType):
-							if (!b.integer) throw Crash(ip, data);
-							stack.push({ .integer = (Int64)((UInt64)a.integer % b.integer) });
-						break;
-						default: return { .integer = 0 };
-					}
-				break;
-				case OPCode::BSL:
+					a = stack.top();
+					if (!Operations::modulo(Encoding::readTypes(data), a, b, s, [&] { crash(data); })) return { .integer = 0 };
+					stack.peek() = s;
+				next;
+				handle(BSL):
 					b = stack.pop();
-					a = stack.pop();
-					switch (data.as.type) {
-						case Type::CharacterType:
-						case      Type::ByteType:
-							stack.push({ .byte = (Byte)(a.byte << (SizeType)b.integer) });
-						break;
-						case   Type::NaturalType:
-						case   Type::IntegerType:
-							stack.push({ .integer = (a.integer << (SizeType)b.integer) });
-						break;
-						default: return { .integer = 0 };
-					}
-				break;
-				case OPCode::BSR:
+					a = stack.top();
+					if (!Operations::shiftLeft(Encoding::readType(data), a, b, s)) return { .integer = 0 };
+					stack.peek() = s;
+				next;
+				handle(BSR):
 					b = stack.pop();
-					a = stack.pop();
-					switch (data.as.type) {
-						case Type::CharacterType:
-						case      Type::ByteType:
-							stack.push({ .byte = (Byte)(a.byte >> (SizeType)b.integer) });
-						break;
-						case   Type::NaturalType:
-						case   Type::IntegerType:
-							stack.push({ .integer = (a.integer >> (SizeType)b.integer) });
-						break;
-						default: return { .integer = 0 };
-					}
-				break;
-				case OPCode::BRL:
+					a = stack.top();
+					if (!Operations::shiftRight(Encoding::readType(data), a, b, s)) return { .integer = 0 };
+					stack.peek() = s;
+				next;
+				handle(BRL):
 					b = stack.pop();
-					a = stack.pop();
-					switch (data.as.type) {
-						case Type::CharacterType:
-						case      Type::ByteType:
-							stack.push({ .byte = (Byte)(
-								a.byte << (SizeType)b.integer |
-								a.byte >> (8 - (SizeType)b.integer)
-							) });
-						break;
-						case   Type::NaturalType:
-						case   Type::IntegerType:
-							stack.push({ .integer = (
-								a.integer << (SizeType)b.integer |
-								a.integer >> (64 - (SizeType)b.integer)
-							) });
-						break;
-						default: return { .integer = 0 };
-					}
-				break;
-				case OPCode::BRR:
+					a = stack.top();
+					if (!Operations::rotateLeft(Encoding::readType(data), a, b, s)) return { .integer = 0 };
+					stack.peek() = s;
+				next;
+				handle(BRR):
 					b = stack.pop();
-					a = stack.pop();
-					switch (data.as.type) {
-						case Type::CharacterType:
-						case      Type::ByteType:
-							stack.push({ .byte = (Byte)(
-								a.byte >> (SizeType)b.integer |
-								a.byte << (8 - (SizeType)b.integer)
-							) });
-						break;
-						case   Type::NaturalType:
-						case   Type::IntegerType:
-							stack.push({ .integer = (
-								a.integer >> (SizeType)b.integer |
-								a.integer << (64 - (SizeType)b.integer)
-							) });
-						break;
-						default: return { .integer = 0 };
+					a = stack.top();
+					if (!Operations::rotateRight(Encoding::readType(data), a, b, s)) return { .integer = 0 };
+					stack.peek() = s;
+				next;
+				handle(NEG):
+					a = stack.top();
+					if (Operations::negate(Encoding::readType(data), a, s)) {
+						stack.peek() = s; next;
 					}
-				break;
-				case OPCode::NEG:
-					switch (data.as.type) {
-						case Type::CharacterType:
-						case      Type::ByteType: stack.push({ .integer = - stack.pop().byte }); break;
-						case   Type::NaturalType:
-						case   Type::IntegerType: stack.push({ .integer = - stack.pop().integer }); break;
-						case      Type::RealType:
-						case Type::ImaginaryType: stack.push({ .real = - stack.pop().real }); break;
+					stack.decrease();
+					switch (Encoding::readType(data)) {
+						// Basic Objects:
 						case   Type::ComplexType: {
-							Complex * complex = (Complex *)stack.pop().pointer;
-							complex = new Complex(
+							Complex * complex = (Complex *)a.pointer;
+							complex = collector.complex(
 								- (complex -> a),
 								- (complex -> b)
 							);
-							objects.push_back({ complex, Type::ComplexType });
 							stack.push({ .pointer = complex });
 						} break;
 						default: return { .integer = 0 };
 					}
-				break;
-				case OPCode::INV:
-					switch (data.as.type) {
-						case Type::NaturalType: stack.push({ .integer = (Int64)(~((UInt64)stack.pop().integer)) });
-						case Type::IntegerType: stack.push({ .integer = ~(stack.pop().integer) });
-						case    Type::ByteType: stack.push({ .byte = (Byte)(~(stack.pop().byte)) });
-						default: return { .integer = 0 };
-					}
-				break;
-				case OPCode::SGS:
+				next;
+				handle(INV):
+					a = stack.top();
+					if (!Operations::invert(Encoding::readType(data), a, s)) return { .integer = 0 };
+					stack.peek() = s;
+				next;
+				handle(SGS):
 					b = stack.pop();
 					a = stack.pop();
 					if (b.integer < 0 ||
-						b.integer > (((String *)a.pointer) -> size()) - 1) throw Crash(ip, data);
+						b.integer > (((String *)a.pointer) -> size()) - 1) crash(data);
 					stack.push({
 						.byte = (Byte)((String *)a.pointer) -> at(b.integer)
 					});
-				break;
-				case OPCode::SSS:
+				next;
+				handle(SSS):
 					c = stack.pop(); // expression
 					b = stack.pop(); // index
 					a = stack.pop(); // string pointer
 					if (b.integer < 0 ||
-						b.integer > (((String *)a.pointer) -> size()) - 1) throw Crash(ip, data);
+						b.integer > (((String *)a.pointer) -> size()) - 1) crash(data);
 					((String *)a.pointer) -> operator [] (b.integer) = (Character)c.byte;
 					stack.push(c);
-				break;
-				case OPCode::AGS:
+				next;
+				handle(AGS):
 					b = stack.pop();
 					a = stack.pop();
 					if (b.integer < 0 ||
-						b.integer > (((Array<Value> *)a.pointer) -> size()) - 1) throw Crash(ip, data);
+						b.integer > (((Array<Value> *)a.pointer) -> size()) - 1) crash(data);
 					stack.push(((Array<Value> *)a.pointer) -> at(b.integer));
-				break;
-				case OPCode::ASS:
+				next;
+				handle(ASS):
 					c = stack.pop(); // expression
 					b = stack.pop(); // index
 					a = stack.pop(); // array pointer
-					if (b.integer < 0) throw Crash(ip, data);
+					if (b.integer < 0) crash(data);
 					while (b.integer >= ((Array<Value> *)a.pointer) -> size())
 						((Array<Value> *)a.pointer) -> push_back(c);
 					((Array<Value> *)a.pointer) -> operator [] (b.integer) = c;
 					stack.push(c);
-				break;
-				case OPCode::SCN:
+				next;
+				handle(SCN):
 					stack.push({
 						.integer = (Int64)(
 							((String *)stack.pop().pointer) -> length()
 						)
 					});
-				break;
-				case OPCode::ACN:
+				next;
+				handle(ACN):
 					stack.push({
 						.integer = (Int64)(
 							((Array<Value> *)stack.pop().pointer) -> size()
 						)
 					});
-				break;
-				case OPCode::CCJ:
-					stack.push({ .pointer = new Complex(
+				next;
+				handle(CCJ):
+					stack.push({ .pointer = collector.complex(
 						((Complex *)stack.pop().pointer) -> getConjugate()
 					)});
-					objects.push_back({ stack.top().pointer, Type::ComplexType });
-				break;
-				case OPCode::VCJ: break;
-				case OPCode::MCJ: break;
-				case OPCode::PST: stack.push({ .boolean = true }); break;
-				case OPCode::PSF: stack.push({ .boolean = false }); break;
-				case OPCode::PSI: stack.push({ .real = infinity }); break;
-				case OPCode::PSU: stack.push({ .real = undefined }); break;
-				case OPCode::PEC:
-					stack.push({ .pointer = new Complex() });
-					objects.push_back({ stack.top().pointer, Type::ComplexType });
-				break;
-				case OPCode::PES:
-					stack.push({ .pointer = new String() });
-					objects.push_back({ stack.top().pointer, Type::StringType });
-				break;
-				case OPCode::PSA: {
-					Array<Value> * array = new Array<Value>();
-					array -> reserve(data.as.index);
-					SizeType i = stack.size() - data.as.index;
+				next;
+				handle(VCJ): next;
+				handle(MCJ): next;
+				handle(PST): stack.push({ .boolean = true }); next;
+				handle(PSF): stack.push({ .boolean = false }); next;
+				handle(PSI): stack.push({ .real = infinity }); next;
+				handle(PSU): stack.push({ .real = undefined }); next;
+				handle(PEC):
+					stack.push({ .pointer = collector.complex(Complex()) });
+				next;
+				handle(PES):
+					stack.push({ .pointer = collector.string() });
+				next;
+				handle(PSA): {
+					bounded(Encoding::readIndex(data), stack.size() + 1);
+					Array<Value> * array = collector.array();
+					array -> reserve(Encoding::readIndex(data));
+					SizeType i = stack.size() - Encoding::readIndex(data);
 					const SizeType size = stack.size();
 					while (i < size) {
 						array -> push_back(stack.at(i));
 						i += 1;
 					}
-					stack.decrease(data.as.index);
+					stack.decrease(Encoding::readIndex(data));
 					stack.push({ .pointer = array });
-					objects.push_back({ array, Type::ArrayType });
-				} break;
-				case OPCode::PEA:
-					stack.push({ .pointer = new Array<Value>() });
-					objects.push_back({ stack.top().pointer, Type::ArrayType });
-				break;
-				case OPCode::POP: stack.decrease(); break;
-				case OPCode::DHD: stack.push(stack.top()); break;
-				case OPCode::DSK: stack.decrease(data.as.index); break;
-				case OPCode::JMP: ip = data.as.index; continue;
-				case OPCode::JIF: if (!stack.pop().boolean) { ip = data.as.index; continue; } break;
-				case OPCode::JAF: if (!stack.top().boolean) { ip = data.as.index; continue; } break;
-				case OPCode::JIT: if  (stack.pop().boolean) { ip = data.as.index; continue; } break;
-				case OPCode::JAT: if  (stack.top().boolean) { ip = data.as.index; continue; } break;
-				case OPCode::EQL:
+				} next;
+				handle(PEA):
+					stack.push({ .pointer = collector.array() });
+				next;
+				handle(POP): stack.decrease(); next;
+				handle(DHD): stack.push(stack.top()); next;
+				handle(DSK):
+					bounded(Encoding::readIndex(data), stack.size() + 1);
+					stack.decrease(Encoding::readIndex(data));
+				next;
+				handle(JMP):
+					// Backward jumps close loops:
+					if (code + Encoding::readIndex(data) < data) {
+						data = code + Encoding::readIndex(data);
+						safepoint;
+						enter(true);
+					} else data = code + Encoding::readIndex(data);
+				jump;
+				handle(JIF): if (!stack.pop().boolean) { data = code + Encoding::readIndex(data); jump; } next;
+				handle(JAF): if (!stack.top().boolean) { data = code + Encoding::readIndex(data); jump; } next;
+				handle(JIT): if  (stack.pop().boolean) { data = code + Encoding::readIndex(data); jump; } next;
+				handle(JAT): if  (stack.top().boolean) { data = code + Encoding::readIndex(data); jump; } next;
+				handle(EQL):
 					b = stack.pop();
-					a = stack.pop();
-					switch (data.as.types) {
-						// Basic Types:
-						case compose(Type::BooleanType, Type::BooleanType):
-							stack.push({ .boolean = (a.boolean == b.boolean) });
-						break;
-						case compose(Type::CharacterType, Type::CharacterType):
-						case compose(Type::CharacterType, Type::ByteType):
-						case compose(Type::ByteType, Type::CharacterType):
-						case compose(Type::ByteType, Type::ByteType):
-							stack.push({ .boolean = (a.byte == b.byte) });
-						break;
-						case compose(Type::ByteType, Type::NaturalType):
-							stack.push({ .boolean = (((UInt64)a.byte) == b.integer) });
-						break;
-						case compose(Type::CharacterType, Type::IntegerType):
-						case compose(Type::ByteType, Type::IntegerType):
-							stack.push({ .boolean = (((Int64)a.byte) == b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::ByteType):
-							stack.push({ .boolean = (((UInt64)a.integer) == (UInt64)b.byte) });
-						break;
-						case compose(Type::NaturalType, Type::NaturalType):
-							stack.push({ .boolean = (((UInt64)a.integer) == (UInt64)b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::IntegerType):
-							stack.push({ .boolean = (((UInt64)a.integer) == b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::RealType):
-							stack.push({ .boolean = (((UInt64)a.integer) == b.real) });
-						break;
-						case compose(Type::IntegerType, Type::CharacterType):
-						case compose(Type::IntegerType, Type::ByteType):
-							stack.push({ .boolean = (a.integer == ((Int64)b.byte)) });
-						break;
-						case compose(Type::IntegerType, Type::NaturalType):
-							stack.push({ .boolean = (a.integer == (UInt64)b.integer) });
-						break;
-						case compose(Type::IntegerType, Type::IntegerType):
-							stack.push({ .boolean = (a.integer == b.integer) });
-						break;
-						case compose(Type::IntegerType, Type::RealType):
-							stack.push({ .boolean = (((Real)a.integer) == b.real) });
-						break;
-						case compose(Type::RealType, Type::NaturalType):
-							stack.push({ .boolean = (a.real == ((Real)((UInt64)b.integer))) });
-						break;
-						case compose(Type::RealType, Type::IntegerType):
-							stack.push({ .boolean = (a.real == ((Real)b.integer)) });
-						break;
-						case compose(Type::RealType, Type::RealType):
-						case compose(Type::ImaginaryType, Type::ImaginaryType):
-							stack.push({ .boolean = (a.real == b.real) });
-						break;
+					a = stack.top();
+					if (Operations::equal(Encoding::readTypes(data), a, b, s)) {
+						stack.peek() = s; next;
+					}
+					stack.decrease();
+					switch (Encoding::readTypes(data)) {
 						// Basic Objects:
 						case compose(Type::StringType, Type::StringType):
 							stack.push({ .boolean = ((*((String *)a.pointer)) == (*(String *)b.pointer)) });
@@ -1054,63 +877,15 @@ namespace Spin {
 						break;
 						default: return { .integer = 0 };
 					}
-				break;
-				case OPCode::NEQ:
+				next;
+				handle(NEQ):
 					b = stack.pop();
-					a = stack.pop();
-					switch (data.as.types) {
-						// Basic Types:
-						case compose(Type::BooleanType, Type::BooleanType):
-							stack.push({ .boolean = (a.boolean != b.boolean) });
-						break;
-						case compose(Type::CharacterType, Type::CharacterType):
-						case compose(Type::CharacterType, Type::ByteType):
-						case compose(Type::ByteType, Type::CharacterType):
-						case compose(Type::ByteType, Type::ByteType):
-							stack.push({ .boolean = (a.byte != b.byte) });
-						break;
-						case compose(Type::ByteType, Type::NaturalType):
-							stack.push({ .boolean = (((UInt64)a.byte) != b.integer) });
-						break;
-						case compose(Type::CharacterType, Type::IntegerType):
-						case compose(Type::ByteType, Type::IntegerType):
-							stack.push({ .boolean = (((Int64)a.byte) != b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::ByteType):
-							stack.push({ .boolean = (((UInt64)a.integer) != (UInt64)b.byte) });
-						break;
-						case compose(Type::NaturalType, Type::NaturalType):
-							stack.push({ .boolean = (((UInt64)a.integer) != (UInt64)b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::IntegerType):
-							stack.push({ .boolean = (((UInt64)a.integer) != b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::RealType):
-							stack.push({ .boolean = (((UInt64)a.integer) != b.real) });
-						break;
-						case compose(Type::IntegerType, Type::CharacterType):
-						case compose(Type::IntegerType, Type::ByteType):
-							stack.push({ .boolean = (a.integer != ((Int64)b.byte)) });
-						break;
-						case compose(Type::IntegerType, Type::NaturalType):
-							stack.push({ .boolean = (a.integer != (UInt64)b.integer) });
-						break;
-						case compose(Type::IntegerType, Type::IntegerType):
-							stack.push({ .boolean = (a.integer != b.integer) });
-						break;
-						case compose(Type::IntegerType, Type::RealType):
-							stack.push({ .boolean = (((Real)a.integer) != b.real) });
-						break;
-						case compose(Type::RealType, Type::NaturalType):
-							stack.push({ .boolean = (a.real != ((Real)((UInt64)b.integer))) });
-						break;
-						case compose(Type::RealType, Type::IntegerType):
-							stack.push({ .boolean = (a.real != ((Real)b.integer)) });
-						break;
-						case compose(Type::RealType, Type::RealType):
-						case compose(Type::ImaginaryType, Type::ImaginaryType):
-							stack.push({ .boolean = (a.real != b.real) });
-						break;
+					a = stack.top();
+					if (Operations::different(Encoding::readTypes(data), a, b, s)) {
+						stack.peek() = s; next;
+					}
+					stack.decrease();
+					switch (Encoding::readTypes(data)) {
 						// Basic Objects:
 						case compose(Type::StringType, Type::StringType):
 							stack.push({ .boolean = ((*((String *)a.pointer)) != (*(String *)b.pointer)) });
@@ -1120,302 +895,58 @@ namespace Spin {
 						break;
 						default: return { .integer = 0 };
 					}
-				break;
-				case OPCode::GRT:
+				next;
+				handle(GRT):
 					b = stack.pop();
-					a = stack.pop();
-					switch (data.as.types) {
-						// Basic Types:
-						case compose(Type::BooleanType, Type::BooleanType):
-							stack.push({ .boolean = (a.boolean > b.boolean) });
-						break;
-						case compose(Type::CharacterType, Type::CharacterType):
-						case compose(Type::CharacterType, Type::ByteType):
-						case compose(Type::ByteType, Type::CharacterType):
-						case compose(Type::ByteType, Type::ByteType):
-							stack.push({ .boolean = (a.byte > b.byte) });
-						break;
-						case compose(Type::ByteType, Type::NaturalType):
-							stack.push({ .boolean = (((UInt64)a.byte) > b.integer) });
-						break;
-						case compose(Type::CharacterType, Type::IntegerType):
-						case compose(Type::ByteType, Type::IntegerType):
-							stack.push({ .boolean = (((Int64)a.byte) > b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::ByteType):
-							stack.push({ .boolean = (((UInt64)a.integer) > (UInt64)b.byte) });
-						break;
-						case compose(Type::NaturalType, Type::NaturalType):
-							stack.push({ .boolean = (((UInt64)a.integer) > (UInt64)b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::IntegerType):
-							stack.push({ .boolean = (a.integer > b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::RealType):
-							stack.push({ .boolean = (((UInt64)a.integer) > b.real) });
-						break;
-						case compose(Type::IntegerType, Type::CharacterType):
-						case compose(Type::IntegerType, Type::ByteType):
-							stack.push({ .boolean = (a.integer > ((Int64)b.byte)) });
-						break;
-						case compose(Type::IntegerType, Type::NaturalType):
-							stack.push({ .boolean = (a.integer > b.integer) });
-						break;
-						case compose(Type::IntegerType, Type::IntegerType):
-							stack.push({ .boolean = (a.integer > b.integer) });
-						break;
-						case compose(Type::IntegerType, Type::RealType):
-							stack.push({ .boolean = (((Real)a.integer) > b.real) });
-						break;
-						case compose(Type::RealType, Type::NaturalType):
-							stack.push({ .boolean = (a.real > ((Real)((UInt64)b.integer))) });
-						break;
-						case compose(Type::RealType, Type::IntegerType):
-							stack.push({ .boolean = (a.real > ((Real)b.integer)) });
-						break;
-						case compose(Type::RealType, Type::RealType):
-						case compose(Type::ImaginaryType, Type::ImaginaryType):
-							stack.push({ .boolean = (a.real > b.real) });
-						break;
-						default: return { .integer = 0 };
-					}
-				break;
-				case OPCode::GEQ:
+					a = stack.top();
+					if (!Operations::greater(Encoding::readTypes(data), a, b, s)) return { .integer = 0 };
+					stack.peek() = s;
+				next;
+				handle(GEQ):
 					b = stack.pop();
-					a = stack.pop();
-					switch (data.as.types) {
-						// Basic Types:
-						case compose(Type::BooleanType, Type::BooleanType):
-							stack.push({ .boolean = (a.boolean >= b.boolean) });
-						break;
-						case compose(Type::CharacterType, Type::CharacterType):
-						case compose(Type::CharacterType, Type::ByteType):
-						case compose(Type::ByteType, Type::CharacterType):
-						case compose(Type::ByteType, Type::ByteType):
-							stack.push({ .boolean = (a.byte >= b.byte) });
-						break;
-						case compose(Type::ByteType, Type::NaturalType):
-							stack.push({ .boolean = (((UInt64)a.byte) >= b.integer) });
-						break;
-						case compose(Type::CharacterType, Type::IntegerType):
-						case compose(Type::ByteType, Type::IntegerType):
-							stack.push({ .boolean = (((Int64)a.byte) >= b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::ByteType):
-							stack.push({ .boolean = (((UInt64)a.integer) >= (UInt64)b.byte) });
-						break;
-						case compose(Type::NaturalType, Type::NaturalType):
-							stack.push({ .boolean = (((UInt64)a.integer) >= (UInt64)b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::IntegerType):
-							stack.push({ .boolean = (a.integer >= b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::RealType):
-							stack.push({ .boolean = (((UInt64)a.integer) >= b.real) });
-						break;
-						case compose(Type::IntegerType, Type::CharacterType):
-						case compose(Type::IntegerType, Type::ByteType):
-							stack.push({ .boolean = (a.integer >= ((Int64)b.byte)) });
-						break;
-						case compose(Type::IntegerType, Type::NaturalType):
-							stack.push({ .boolean = (a.integer >= b.integer) });
-						break;
-						case compose(Type::IntegerType, Type::IntegerType):
-							stack.push({ .boolean = (a.integer >= b.integer) });
-						break;
-						case compose(Type::IntegerType, Type::RealType):
-							stack.push({ .boolean = (((Real)a.integer) >= b.real) });
-						break;
-						case compose(Type::RealType, Type::NaturalType):
-							stack.push({ .boolean = (a.real >= ((Real)((UInt64)b.integer))) });
-						break;
-						case compose(Type::RealType, Type::IntegerType):
-							stack.push({ .boolean = (a.real >= ((Real)b.integer)) });
-						break;
-						case compose(Type::RealType, Type::RealType):
-						case compose(Type::ImaginaryType, Type::ImaginaryType):
-							stack.push({ .boolean = (a.real >= b.real) });
-						break;
-						default: return { .integer = 0 };
-					}
-				break;
-				case OPCode::LSS:
+					a = stack.top();
+					if (!Operations::greaterEqual(Encoding::readTypes(data), a, b, s)) return { .integer = 0 };
+					stack.peek() = s;
+				next;
+				handle(LSS):
 					b = stack.pop();
-					a = stack.pop();
-					switch (data.as.types) {
-						// Basic Types:
-						case compose(Type::BooleanType, Type::BooleanType):
-							stack.push({ .boolean = (a.boolean < b.boolean) });
-						break;
-						case compose(Type::CharacterType, Type::CharacterType):
-						case compose(Type::CharacterType, Type::ByteType):
-						case compose(Type::ByteType, Type::CharacterType):
-						case compose(Type::ByteType, Type::ByteType):
-							stack.push({ .boolean = (a.byte < b.byte) });
-						break;
-						case compose(Type::ByteType, Type::NaturalType):
-							stack.push({ .boolean = (((UInt64)a.byte) < b.integer) });
-						break;
-						case compose(Type::CharacterType, Type::IntegerType):
-						case compose(Type::ByteType, Type::IntegerType):
-							stack.push({ .boolean = (((Int64)a.byte) < b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::ByteType):
-							stack.push({ .boolean = (((UInt64)a.integer) < (UInt64)b.byte) });
-						break;
-						case compose(Type::NaturalType, Type::NaturalType):
-							stack.push({ .boolean = (((UInt64)a.integer) < (UInt64)b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::IntegerType):
-							stack.push({ .boolean = (a.integer < b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::RealType):
-							stack.push({ .boolean = (((UInt64)a.integer) < b.real) });
-						break;
-						case compose(Type::IntegerType, Type::CharacterType):
-						case compose(Type::IntegerType, Type::ByteType):
-							stack.push({ .boolean = (a.integer < ((Int64)b.byte)) });
-						break;
-						case compose(Type::IntegerType, Type::NaturalType):
-							stack.push({ .boolean = (a.integer < b.integer) });
-						break;
-						case compose(Type::IntegerType, Type::IntegerType):
-							stack.push({ .boolean = (a.integer < b.integer) });
-						break;
-						case compose(Type::IntegerType, Type::RealType):
-							stack.push({ .boolean = (((Real)a.integer) < b.real) });
-						break;
-						case compose(Type::RealType, Type::NaturalType):
-							stack.push({ .boolean = (a.real < ((Real)((UInt64)b.integer))) });
-						break;
-						case compose(Type::RealType, Type::IntegerType):
-							stack.push({ .boolean = (a.real < ((Real)b.integer)) });
-						break;
-						case compose(Type::RealType, Type::RealType):
-						case compose(Type::ImaginaryType, Type::ImaginaryType):
-							stack.push({ .boolean = (a.real < b.real) });
-						break;
-						default: return { .integer = 0 };
-					}
-				break;
-				case OPCode::LEQ:
+					a = stack.top();
+					if (!Operations::less(Encoding::readTypes(data), a, b, s)) return { .integer = 0 };
+					stack.peek() = s;
+				next;
+				handle(LEQ):
 					b = stack.pop();
-					a = stack.pop();
-					switch (data.as.types) {
-						// Basic Types:
-						case compose(Type::BooleanType, Type::BooleanType):
-							stack.push({ .boolean = (a.boolean <= b.boolean) });
-						break;
-						case compose(Type::CharacterType, Type::CharacterType):
-						case compose(Type::CharacterType, Type::ByteType):
-						case compose(Type::ByteType, Type::CharacterType):
-						case compose(Type::ByteType, Type::ByteType):
-							stack.push({ .boolean = (a.byte <= b.byte) });
-						break;
-						case compose(Type::ByteType, Type::NaturalType):
-							stack.push({ .boolean = (((UInt64)a.byte) <= b.integer) });
-						break;
-						case compose(Type::CharacterType, Type::IntegerType):
-						case compose(Type::ByteType, Type::IntegerType):
-							stack.push({ .boolean = (((Int64)a.byte) <= b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::ByteType):
-							stack.push({ .boolean = (((UInt64)a.integer) <= (UInt64)b.byte) });
-						break;
-						case compose(Type::NaturalType, Type::NaturalType):
-							stack.push({ .boolean = (((UInt64)a.integer) <= (UInt64)b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::IntegerType):
-							stack.push({ .boolean = (a.integer <= b.integer) });
-						break;
-						case compose(Type::NaturalType, Type::RealType):
-							stack.push({ .boolean = (((UInt64)a.integer) <= b.real) });
-						break;
-						case compose(Type::IntegerType, Type::CharacterType):
-						case compose(Type::IntegerType, Type::ByteType):
-							stack.push({ .boolean = (a.integer <= ((Int64)b.byte)) });
-						break;
-						case compose(Type::IntegerType, Type::NaturalType):
-							stack.push({ .boolean = (a.integer <= b.integer) });
-						break;
-						case compose(Type::IntegerType, Type::IntegerType):
-							stack.push({ .boolean = (a.integer <= b.integer) });
-						break;
-						case compose(Type::IntegerType, Type::RealType):
-							stack.push({ .boolean = (((Real)a.integer) <= b.real) });
-						break;
-						case compose(Type::RealType, Type::NaturalType):
-							stack.push({ .boolean = (a.real <= ((Real)((UInt64)b.integer))) });
-						break;
-						case compose(Type::RealType, Type::IntegerType):
-							stack.push({ .boolean = (a.real <= ((Real)b.integer)) });
-						break;
-						case compose(Type::RealType, Type::RealType):
-						case compose(Type::ImaginaryType, Type::ImaginaryType):
-							stack.push({ .boolean = (a.real <= b.real) });
-						break;
-						default: return { .integer = 0 };
-					}
-				break;
-				case OPCode::NOT: stack.push({ .boolean = !(stack.pop().boolean) }); break;
-				case OPCode::BWA:
+					a = stack.top();
+					if (!Operations::lessEqual(Encoding::readTypes(data), a, b, s)) return { .integer = 0 };
+					stack.peek() = s;
+				next;
+				handle(NOT): stack.peek() = { .boolean = !(stack.top().boolean) }; next;
+				handle(BWA):
 					b = stack.pop();
-					a = stack.pop();
-					switch (data.as.types) {
-						case compose(Type::NaturalType, Type::NaturalType):
-						case compose(Type::IntegerType, Type::IntegerType):
-							stack.push({ .integer = (Int64)((UInt64)a.integer & (UInt64)b.integer) });
-						break;
-						case compose(Type::ByteType, Type::ByteType):
-						case compose(Type::CharacterType, Type::CharacterType):
-							stack.push({ .byte = (Byte)(a.byte & b.byte) });
-						break;
-						case compose(Type::BooleanType, Type::BooleanType):
-							stack.push({ .boolean = a.boolean && b.boolean });
-						break;
-						default: return { .integer = 0 };
-					}
-				break;
-				case OPCode::BWO:
+					a = stack.top();
+					if (!Operations::bitwiseAnd(Encoding::readTypes(data), a, b, s)) return { .integer = 0 };
+					stack.peek() = s;
+				next;
+				handle(BWO):
 					b = stack.pop();
-					a = stack.pop();
-					switch (data.as.types) {
-						case compose(Type::NaturalType, Type::NaturalType):
-						case compose(Type::IntegerType, Type::IntegerType):
-							stack.push({ .integer = (Int64)((UInt64)a.integer | (UInt64)b.integer) });
-						break;
-						case compose(Type::ByteType, Type::ByteType):
-						case compose(Type::CharacterType, Type::CharacterType):
-							stack.push({ .byte = (Byte)(a.byte | b.byte) });
-						break;
-						case compose(Type::BooleanType, Type::BooleanType):
-							stack.push({ .boolean = a.boolean || b.boolean });
-						break;
-						default: return { .integer = 0 };
-					}
-				break;
-				case OPCode::BWX:
+					a = stack.top();
+					if (!Operations::bitwiseOr(Encoding::readTypes(data), a, b, s)) return { .integer = 0 };
+					stack.peek() = s;
+				next;
+				handle(BWX):
 					b = stack.pop();
-					a = stack.pop();
-					switch (data.as.types) {
-						case compose(Type::NaturalType, Type::NaturalType):
-						case compose(Type::IntegerType, Type::IntegerType):
-							stack.push({ .integer = (Int64)((UInt64)a.integer ^ (UInt64)b.integer) });
-						break;
-						case compose(Type::ByteType, Type::ByteType):
-						case compose(Type::CharacterType, Type::CharacterType):
-							stack.push({ .byte = (Byte)(a.byte ^ b.byte) });
-						break;
-						default: return { .integer = 0 };
-					}
-				break;
-				case OPCode::CLL:
-					switch (data.as.types) {
+					a = stack.top();
+					if (!Operations::bitwiseXor(Encoding::readTypes(data), a, b, s)) return { .integer = 0 };
+					stack.peek() = s;
+				next;
+				handle(CLL):
+					switch (Encoding::readTypes(data)) {
 						// Boolean:
 						case NativeCodes::Boolean_string:
-							if (stack.pop().boolean) stack.push({ .pointer = new String("true") });
-							else stack.push({ .pointer = new String("false") });
-							objects.push_back({ stack.top().pointer, Type::StringType });
+							// Pushed once its literal is gone (see Trap):
+							if (stack.pop().boolean) s = { .pointer = collector.string("true") };
+							else s = { .pointer = collector.string("false") };
+							stack.push(s);
 						break;
 						
 						/*case Type::StringType:
@@ -1458,7 +989,7 @@ namespace Spin {
 								break;
 								case 0x09: // String.ends(with: String)
 								break;
-								default: throw Crash(ip, data);
+								default: crash(data);
 							}
 						break;
 						case Type::ArrayType:
@@ -1474,133 +1005,115 @@ namespace Spin {
 									a = stack.pop();
 									((Array<Value> *)(stack.pop().pointer)) -> push_back(a);
 								break;
-								default: throw Crash(ip, data);
+								default: crash(data);
 							}
 						break;*/
-						default: throw Crash(ip, data);
+						default: crash(data);
+					}
+				next;
+				handle(CAL):
+					frames.peek().address = (data - code) + Encoding::lengths.of[OPCode::CAL];
+					data = code + Encoding::readIndex(data);
+					frames.peek().routine = data - code;
+					safepoint;
+					enter(true);
+				jump;
+				handle(TCL): {
+					// The arguments, above the frame set by
+					// the SSF before, replace the frame of
+					// the current routine, so that its callee
+					// returns straight to its caller:
+					const SizeType from = base;
+					base = frames.pop().base;
+					const SizeType count = stack.size() - from;
+					for (SizeType i = 0; i < count; i += 1) {
+						stack.edit(base + i, stack.at(from + i));
 					}
-				break;
-				case OPCode::CAL: call.push(ip); ip = data.as.index; continue;
-				case OPCode::RET: base = frame.pop(); ip = call.pop(); break;
-				case OPCode::CST:
+					stack.resize(base + count);
+					data = code + Encoding::readIndex(data);
+					frames.peek().routine = data - code;
+					safepoint;
+					enter(true);
+				} jump;
+				handle(RET): {
+					const Frame frame = frames.pop();
+					base = frame.base;
+					data = code + frame.address;
+					enter(false);
+				} jump;
+				handle(CST):
 					// Attention! Has to be read from l to r: ((r)l).
 					//            It will always return type of r.
-					switch (data.as.types) {
-						// Basic Types:
-						case compose(Type::CharacterType, Type::ByteType):
-						case compose(Type::ByteType, Type::CharacterType): break;
-						case compose(Type::CharacterType, Type::IntegerType):
-						case compose(Type::ByteType, Type::IntegerType):
-						case compose(Type::ByteType, Type::NaturalType):
-							stack.push({ .integer = (Int64)stack.pop().byte });
-						break;
-						case compose(Type::NaturalType, Type::ByteType):
-						case compose(Type::IntegerType, Type::CharacterType):
-						case compose(Type::IntegerType, Type::ByteType):
-							stack.push({ .byte = (Byte)stack.pop().integer });
-						break;
-						case compose(Type::NaturalType, Type::RealType):
-							stack.push({ .real = (Real)((UInt64)stack.pop().integer) });
-						break;
-						case compose(Type::IntegerType, Type::RealType):
-							stack.push({ .real = (Real)stack.pop().integer });
-						break;
-						case compose(Type::RealType, Type::NaturalType):
-							stack.push({ .integer = (Int64)((UInt64)stack.pop().real) });
-						break;
-						case compose(Type::RealType, Type::IntegerType):
-							stack.push({ .integer = (Int64)stack.pop().real });
-						break;
+					a = stack.top();
+					if (Operations::cast(Encoding::readTypes(data), a, s)) {
+						stack.peek() = s; next;
+					}
+					stack.decrease();
+					switch (Encoding::readTypes(data)) {
 						// Basic Objects:
 						case compose(Type::NaturalType, Type::ComplexType): {
-							Complex * complex = new Complex((Real)((UInt64)stack.pop().integer), 0.0);
-							objects.push_back({ complex, Type::ComplexType });
+							Complex * complex = collector.complex((Real)((UInt64)a.integer), 0.0);
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::IntegerType, Type::ComplexType): {
-							Complex * complex = new Complex((Real)stack.pop().integer, 0.0);
-							objects.push_back({ complex, Type::ComplexType });
+							Complex * complex = collector.complex((Real)a.integer, 0.0);
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::RealType, Type::ComplexType): {
-							Complex * complex = new Complex(stack.pop().real, 0.0);
-							objects.push_back({ complex, Type::ComplexType });
+							Complex * complex = collector.complex(a.real, 0.0);
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ImaginaryType, Type::ComplexType): {
-							Complex * complex = new Complex(0.0, stack.pop().real);
-							objects.push_back({ complex, Type::ComplexType });
+							Complex * complex = collector.complex(0.0, a.real);
 							stack.push({ .pointer = complex });
 						} break;
 						case compose(Type::ComplexType, Type::NaturalType): {
-							stack.push({ .integer = (Int64)((UInt64)(((Complex *)stack.pop().pointer) -> a)) });
+							stack.push({ .integer = (Int64)((UInt64)(((Complex *)a.pointer) -> a)) });
 						} break;
 						case compose(Type::ComplexType, Type::IntegerType): {
-							stack.push({ .integer = (Int64)(((Complex *)stack.pop().pointer) -> a) });
+							stack.push({ .integer = (Int64)(((Complex *)a.pointer) -> a) });
 						} break;
 						case compose(Type::ComplexType, Type::RealType): {
-							stack.push({ .real = (((Complex *)stack.pop().pointer) -> a) });
+							stack.push({ .real = (((Complex *)a.pointer) -> a) });
 						} break;
 						case compose(Type::ComplexType, Type::ImaginaryType): {
-							stack.push({ .real = (((Complex *)stack.pop().pointer) -> b) });
+							stack.push({ .real = (((Complex *)a.pointer) -> b) });
 						} break;
 						case compose(Type::CharacterType, Type::StringType): {
-							String * string = new String(1, (Character)stack.pop().byte);
-							objects.push_back({ string, Type::StringType });
+							String * string = collector.string(1, (Character)a.byte);
 							stack.push({ .pointer = string });
 						} break;
 						default: return { .integer = 0 };
 					}
-				break;
-				case OPCode::INT:
-					switch ((Interrupt)data.as.type) {
+				next;
+				handle(INT):
+					switch ((Interrupt)Encoding::readType(data)) {
 						case Interrupt::write:
-							switch ((Type)stack.pop().byte) {
-								// Basic Types:
-								case   Type::BooleanType: OStream << (stack.pop().boolean ? "true" : "false"); break;
-								case Type::CharacterType: OStream << (Character)stack.pop().byte; break;
-								case      Type::ByteType: OStream << hexadecimal << (Int64)stack.pop().byte << decimal; break;
-								case   Type::NaturalType: OStream << (UInt64)stack.pop().integer; break;
-								case   Type::IntegerType: OStream << stack.pop().integer; break;
-								case      Type::RealType: OStream << Converter::realToString(stack.pop().real); break;
-								case Type::ImaginaryType: OStream << Converter::imaginaryToString(stack.pop().real); break;
-								// Basic Objects:
-								case   Type::ComplexType: OStream << ((Complex *)stack.pop().pointer) -> toString(); break;
-								case    Type::StringType: OStream << (*((String *)stack.pop().pointer)); break;
-								default: return { .integer = 0 };
-							}
+							a = stack.pop();
+							b = stack.pop();
+							if (!Operations::print((Type)a.byte, b, output)) return { .integer = 0 };
 						break;
 						case Interrupt::writeln:
-							switch ((Type)stack.pop().byte) {
-								// Basic Types:
-								case   Type::BooleanType: OStream << (stack.pop().boolean ? "true" : "false") << endLine; break;
-								case Type::CharacterType: OStream << (Character)stack.pop().byte << endLine; break;
-								case      Type::ByteType: OStream << hexadecimal << (Int64)stack.pop().byte << decimal << endLine; break;
-								case   Type::NaturalType: OStream << (UInt64)stack.pop().integer << endLine; break;
-								case   Type::IntegerType: OStream << stack.pop().integer << endLine; break;
-								case      Type::RealType: OStream << Converter::realToString(stack.pop().real) << endLine; break;
-								case Type::ImaginaryType: OStream << Converter::imaginaryToString(stack.pop().real) << endLine; break;
-								// Basic Objects:
-								case   Type::ComplexType: OStream << ((Complex *)stack.pop().pointer) -> toString() << endLine; break;
-								case    Type::StringType: OStream << (*((String *)stack.pop().pointer)) << endLine; break;
-								default: return { .integer = 0 };
-							}
+							a = stack.pop();
+							b = stack.pop();
+							if (!Operations::print((Type)a.byte, b, output)) return { .integer = 0 };
+							output.line();
 						break;
+						// Pushed once the line is gone (see Trap):
 						case Interrupt::read: {
-							String input;
-							IStream >> input;
-							String * inputPtr = new String(input);
-							stack.push({ .pointer = inputPtr });
-							objects.push_back({ inputPtr, Type::StringType });
-						} break;
+							String line;
+							output.flush();
+							* input >> line;
+							s = { .pointer = collector.string(line) };
+						} stack.push(s); break;
 						case Interrupt::readln: {
-							String input;
-							std::getline(IStream, input);
-							String * inputPtr = new String(input);
-							stack.push({ .pointer = inputPtr });
-							objects.push_back({ inputPtr, Type::StringType });
-						} break;
+							String line;
+							output.flush();
+							std::getline(* input, line);
+							s = { .pointer = collector.string(line) };
+						} stack.push(s); break;
 						case Interrupt::sleep:
+							output.flush();
 							std::this_thread::sleep_for(
 								std::chrono::milliseconds(
 									(UInt64)stack.pop().integer
@@ -1619,45 +1132,278 @@ namespace Spin {
 							stack.push({ .integer = dist(engine) });
 						break;
 					}
-				break;
-				case OPCode::HLT:
+				next;
+				handle(HLT):
 					// Free:
 					stack.clear();
-					freeObjects();
+					collector.clear();
 					return { .integer = 0 };
-				break;
-				default: throw Crash(ip, data);
+				next;
+				// Specialised:
+				handle(ADI):
+					b = stack.pop();
+					a = stack.top();
+					stack.peek() = { .integer = a.integer + b.integer };
+				next;
+				handle(SBI):
+					b = stack.pop();
+					a = stack.top();
+					stack.peek() = { .integer = a.integer - b.integer };
+				next;
+				handle(MLI):
+					b = stack.pop();
+					a = stack.top();
+					stack.peek() = { .integer = (Int64)((UInt64)a.integer * (UInt64)b.integer) };
+				next;
+				handle(DVI):
+					b = stack.pop();
+					a = stack.top();
+					if (!b.integer) crash(data);
+					stack.peek() = { .integer = a.integer / b.integer };
+				next;
+				handle(MDI):
+					b = stack.pop();
+					a = stack.top();
+					if (!b.integer) crash(data);
+					stack.peek() = { .integer = a.integer % b.integer };
+				next;
+				handle(ADR):
+					b = stack.pop();
+					a = stack.top();
+					stack.peek() = { .real = a.real + b.real };
+				next;
+				handle(SBR):
+					b = stack.pop();
+					a = stack.top();
+					stack.peek() = { .real = a.real - b.real };
+				next;
+				handle(MLR):
+					b = stack.pop();
+					a = stack.top();
+					stack.peek() = { .real = a.real * b.real };
+				next;
+				handle(DVR):
+					b = stack.pop();
+					a = stack.top();
+					stack.peek() = { .real = a.real / b.real };
+				next;
+				handle(EQI):
+					b = stack.pop();
+					a = stack.top();
+					stack.peek() = { .boolean = (a.integer == b.integer) };
+				next;
+				handle(NEI):
+					b = stack.pop();
+					a = stack.top();
+					stack.peek() = { .boolean = (a.integer != b.integer) };
+				next;
+				handle(GRI):
+					b = stack.pop();
+					a = stack.top();
+					stack.peek() = { .boolean = (a.integer > b.integer) };
+				next;
+				handle(LSI):
+					b = stack.pop();
+					a = stack.top();
+					stack.peek() = { .boolean = (a.integer < b.integer) };
+				next;
+				handle(GEI):
+					b = stack.pop();
+					a = stack.top();
+					stack.peek() = { .boolean = (a.integer >= b.integer) };
+				next;
+				handle(LEI):
+					b = stack.pop();
+					a = stack.top();
+					stack.peek() = { .boolean = (a.integer <= b.integer) };
+				next;
+				handle(EQR):
+					b = stack.pop();
+					a = stack.top();
+					stack.peek() = { .boolean = (a.real == b.real) };
+				next;
+				handle(NER):
+					b = stack.pop();
+					a = stack.top();
+					stack.peek() = { .boolean = (a.real != b.real) };
+				next;
+				handle(GRR):
+					b = stack.pop();
+					a = stack.top();
+					stack.peek() = { .boolean = (a.real > b.real) };
+				next;
+				handle(LSR):
+					b = stack.pop();
+					a = stack.top();
+					stack.peek() = { .boolean = (a.real < b.real) };
+				next;
+				handle(GER):
+					b = stack.pop();
+					a = stack.top();
+					stack.peek() = { .boolean = (a.real >= b.real) };
+				next;
+				handle(LER):
+					b = stack.pop();
+					a = stack.top();
+					stack.peek() = { .boolean = (a.real <= b.real) };
+				next;
+				// Compare and Jump:
+				handle(JEQ):
+					b = stack.pop();
+					a = stack.pop();
+					if (a.integer == b.integer) { data = code + Encoding::readIndex(data); jump; }
+				next;
+				handle(JNE):
+					b = stack.pop();
+					a = stack.pop();
+					if (a.integer != b.integer) { data = code + Encoding::readIndex(data); jump; }
+				next;
+				handle(JGR):
+					b = stack.pop();
+					a = stack.pop();
+					if (a.integer > b.integer) { data = code + Encoding::readIndex(data); jump; }
+				next;
+				handle(JLS):
+					b = stack.pop();
+					a = stack.pop();
+					if (a.integer < b.integer) { data = code + Encoding::readIndex(data); jump; }
+				next;
+				handle(JGE):
+					b = stack.pop();
+					a = stack.pop();
+					if (a.integer >= b.integer) { data = code + Encoding::readIndex(data); jump; }
+				next;
+				handle(JLE):
+					b = stack.pop();
+					a = stack.pop();
+					if (a.integer <= b.integer) { data = code + Encoding::readIndex(data); jump; }
+				next;
+				// Superinstructions:
+				handle(SEP):
+					bounded(Encoding::readIndex(data), stack.size());
+					stack.edit(Encoding::readIndex(data), stack.pop());
+				next;
+				handle(SFP):
+					bounded(base + Encoding::readIndex(data), stack.size());
+					stack.edit(base + Encoding::readIndex(data), stack.pop());
+				next;
+				handle(GTT):
+					bounded(high(Encoding::readPair(data)), stack.size());
+					bounded(low(Encoding::readPair(data)), stack.size() + 1);
+					stack.push(stack.at(high(Encoding::readPair(data))));
+					stack.push(stack.at(low(Encoding::readPair(data))));
+				next;
+				handle(GFT):
+					bounded(base + high(Encoding::readPair(data)), stack.size());
+					bounded(base + low(Encoding::readPair(data)), stack.size() + 1);
+					stack.push(stack.at(base + high(Encoding::readPair(data))));
+					stack.push(stack.at(base + low(Encoding::readPair(data))));
+				next;
+				handle(GTC):
+					bounded(high(Encoding::readPair(data)), stack.size());
+					stack.push(stack.at(high(Encoding::readPair(data))));
+					stack.push({ .integer = (Int32)low(Encoding::readPair(data)) });
+				next;
+				handle(GFC):
+					bounded(base + high(Encoding::readPair(data)), stack.size());
+					stack.push(stack.at(base + high(Encoding::readPair(data))));
+					stack.push({ .integer = (Int32)low(Encoding::readPair(data)) });
+				next;
+				handle(ADG):
+					bounded(high(Encoding::readPair(data)), stack.size());
+					bounded(low(Encoding::readPair(data)), stack.size());
+					a = stack.at(high(Encoding::readPair(data)));
+					b = stack.at(low(Encoding::readPair(data)));
+					stack.push({ .integer = a.integer + b.integer });
+				next;
+				handle(ADF):
+					bounded(base + high(Encoding::readPair(data)), stack.size());
+					bounded(base + low(Encoding::readPair(data)), stack.size());
+					a = stack.at(base + high(Encoding::readPair(data)));
+					b = stack.at(base + low(Encoding::readPair(data)));
+					stack.push({ .integer = a.integer + b.integer });
+				next;
+				handle(ICG):
+					bounded(high(Encoding::readPair(data)), stack.size());
+					a = stack.at(high(Encoding::readPair(data)));
+					a.integer += (Int32)low(Encoding::readPair(data));
+					stack.edit(high(Encoding::readPair(data)), a);
+				next;
+				handle(ICF):
+					bounded(base + high(Encoding::readPair(data)), stack.size());
+					a = stack.at(base + high(Encoding::readPair(data)));
+					a.integer += (Int32)low(Encoding::readPair(data));
+					stack.edit(base + high(Encoding::readPair(data)), a);
+				next;
+				default:
+				#ifdef SPIN_THREADED
+				crashHandler:
+				#endif
+				crash(data);
 			}
-			ip += 1;
 		}
+		#ifdef SPIN_THREADED
+		endHandler:
+		#endif
 		if (stack.isEmpty()) return { .integer = 0 };
 		return stack.pop();
 	}
 
-	void Processor::run(Program * program) {
-		try { evaluate(program); }
-		catch (Processor::Crash & c) { throw; }
-		stack.clear();
-		freeObjects();
-	}
+	#undef bounded
+	#undef trace
+	#undef enter
+	#undef safepoint
+	#undef handle
+	#ifdef SPIN_THREADED
+		#undef dispatch
+	#endif
+	#undef next
+	#undef jump
 
-	Value Processor::fold(Array<ByteCode> code) {
-		Program * program = new Program();
-		program -> instructions = code;
-		try { return evaluate(program); }
-		catch (Processor::Crash & c) { throw; }
-	}
-
-	void Processor::freeObjects() {
-		for (auto & object : objects) {
-			switch (object.second) {
-				case Type::ComplexType: delete ((String *)object.first); break;
-				case  Type::StringType: delete ((String *)object.first); break;
-				case   Type::ArrayType: delete ((Array<Value> *)object.first); break;
-				default: break;
+	void Processor::run(Program * program, Boolean compiling, UInt32 hotness) {
+		if (!program) return;
+		// Its deepest stack is known up front:
+		if (program -> verified) stack.reserve(program -> depth);
+		// Native code doesn't check its operands:
+		else compiling = false;
+		// Built before the trap, so that a fault doesn't
+		// skip them (nor leave them clobbered):
+		const Encoding encoding(program);
+		Jit jit(& encoding, compiling, hotness);
+		try {
+			#ifdef SPIN_GUARDED
+			// Overflows of the stacks come back here and
+			// crash at the innermost call:
+			Trap trap(stack, frames);
+			if (sigsetjmp(trap.point, 1)) {
+				SizeType address = 0;
+				if (!frames.isEmpty() && frames.peek().address) {
+					address = encoding.address(frames.peek().address) - 1;
+				}
+				throw Crash(address, program -> instructions[address]);
 			}
+			#endif
+			if (program -> verified) evaluate<false>(program, encoding, jit);
+			else evaluate<true>(program, encoding, jit);
 		}
-		objects.clear();
+		catch (Processor::Crash & c) {
+			// Leaves the Processor ready for another run:
+			stack.clear();
+			frames.clear();
+			collector.clear();
+			output.flush();
+			#ifdef SPIN_COUNT
+			if (counters) counters -> stop();
+			#endif
+			throw;
+		}
+		#ifdef SPIN_COUNT
+		if (counters) counters -> stop();
+		#endif
+		stack.clear();
+		frames.clear();
+		collector.clear();
+		output.flush();
 	}
 
 }
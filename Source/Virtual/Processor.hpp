@@ -4,26 +4,55 @@
 #ifndef SPIN_PROCESSOR_HPP
 #define SPIN_PROCESSOR_HPP
 
+#include <istream>
+#include <ostream>
+#include <random>
 #include <vector>
 
-#include "../Utility/Stack.hpp"
+#include "../Utility/Guarded.hpp"
 #include "../Compiler/Program.hpp"
+#include "Collector.hpp"
+#include "Frame.hpp"
+#include "Jit.hpp"
+#include "Output.hpp"
+
+// Threaded dispatch relies on the labels as values
+// extension (clang, gcc), every other compiler, or
+// a build with -DSPIN_PORTABLE, uses the switch:
+
+#if !defined(SPIN_PORTABLE) && (defined(__clang__) || defined(__GNUC__))
+	#define SPIN_THREADED
+#endif
 
 namespace Spin {
 
+	class Counters;
+	class Profiler;
+
+	// Every instance owns its stacks, its heap, its
+	// random engine and its streams, and the only
+	// shared state is immutable, so that different
+	// threads can run their own Processor at once.
+	// The Program can be shared too: it's only read.
 
 	class Processor {
 
 		private:
 
-		static Array<Pair<Pointer, Type>> objects;
+		Collector collector;
 
-		Stack<Value> stack;
-		Stack<SizeType> call;
-		Stack<SizeType> frame;
+		// Reserved values and calls (see Guarded.hpp):
+		static constexpr SizeType values = 1 << 27;
+		static constexpr SizeType calls = 1 << 24;
 
-		Processor() = default;
-		~Processor() = default;
+		Guarded<Value> stack = Guarded<Value>(values);
+		Guarded<Frame> frames = Guarded<Frame>(calls);
+
+		std::mt19937_64 engine;
+
+		// Buffer of the output stream:
+		Output output;
+		std::istream * input = nullptr;
 
 		static consteval Types compose(Type a, Type b) {
 			return (Types)(((Types) a << 8) | b);
@@ -32,9 +61,9 @@ namespace Spin {
 		static const Real infinity;
 		static const Real undefined;
 
-		void freeObjects();
-
-		Value evaluate(Program * program);
+		// Checks the operands of unverified code:
+		template <Boolean checked>
+		Value evaluate(Program * program, const Encoding & encoding, Jit & jit);
 
 		public:
 
@@ -48,18 +77,43 @@ namespace Spin {
 			SizeType getAddress() const;
 		};
 
+		static const Boolean threaded;
+		// Whether it was built with -DSPIN_COUNT:
+		static const Boolean counted;
+
+		// Limits and logging of the garbage collector:
+		Collector::Options heap;
+
+		#ifdef SPIN_TRACE
+		// Called before every instruction with its offset
+		// in the Encoding (see Tests/Tools/Layout.cpp):
+		static void (* tracer)(SizeType offset);
+		#endif
+
+		// Filled while running, when counted:
+		Counters * counters = nullptr;
+		// Sampled at the safe points, when started:
+		Profiler * profiler = nullptr;
+
+		Processor(std::ostream & output = OStream,
+				  std::istream & input = IStream);
+		~Processor() = default;
+
 		Processor(const Processor &) = delete;
 		Processor(Processor &&) = delete;
 		Processor & operator = (const Processor &) = delete;
 		Processor & operator = (Processor &&) = delete;
+
+		// Instance of the command line and the Compiler
+		// (on the standard streams):
 		static Processor * self() {
 			static Processor instance;
 			return & instance;
 		}
 
-		void run(Program * program);
-
-		Value fold(Array<ByteCode> code);
+		// With compiling, hot code runs on the Jit:
+		void run(Program * program, Boolean compiling = false,
+				 UInt32 hotness = Jit::threshold);
 
 	};
 
@@ -0,0 +1,90 @@
+
+/*!
+ *
+ *    + --------------------------------------- +
+ *    |  Profiler.cpp                           |
+ *    |                                         |
+ *    |            Sampling Profiler            |
+ *    |                                         |
+ *    |  Created by Cristian A.                 |
+ *    |  Copyright © MIT. All rights reserved.  |
+ *    + --------------------------------------- +
+ *
+ *    Note: This software is licensed under
+ *          the (MIT) Massachusetts Institute
+ *          of Technology License.
+ *
+!*/
+
+#include "Profiler.hpp"
+
+#ifndef SPIN_PROFILER_CPP
+#define SPIN_PROFILER_CPP
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+#include "../Common/Interface.hpp"
+#include "../Manager/Manager.hpp"
+
+namespace Spin {
+
+	Profiler::Profiler(UInt32 interval): interval(interval) { }
+	Profiler::~Profiler() { stop(); }
+
+	void Profiler::start() {
+		if (running.exchange(true)) return;
+		sampler = std::thread([this] {
+			while (running.load(std::memory_order_relaxed)) {
+				std::this_thread::sleep_for(
+					std::chrono::microseconds(interval)
+				);
+				pending.store(true, std::memory_order_relaxed);
+			}
+		});
+	}
+	void Profiler::stop() {
+		if (!running.exchange(false)) return;
+		sampler.join();
+		pending.store(false, std::memory_order_relaxed);
+	}
+
+	String Profiler::frame(Program * program, SizeType address) {
+		const Program::Routine * routine = program -> routine(address);
+		if (!routine) {
+			// Programs without their table (eg: older binaries):
+			std::stringstream name;
+			name << "0x" << hexadecimal << padding(8) << address;
+			return name.str();
+		}
+		if (!routine -> line) return routine -> name;
+		return routine -> name + ":" + std::to_string(routine -> line);
+	}
+
+	void Profiler::sample(Program * program, const Encoding & encoding,
+						  const Frame * frames, SizeType count) {
+		pending.store(false, std::memory_order_relaxed);
+		// The main code starts at 0:
+		String stack = frame(program, 0);
+		for (SizeType i = 0; i < count; i += 1) {
+			stack += ";";
+			stack += frame(program, encoding.address(frames[i].routine));
+		}
+		stacks[stack] += 1;
+		samples += 1;
+	}
+
+	void Profiler::write(String path) const {
+		Array<Pair<String, UInt64>> sorted(stacks.begin(), stacks.end());
+		std::sort(sorted.begin(), sorted.end());
+		std::stringstream folded;
+		for (auto & stack : sorted) {
+			folded << stack.first << " " << stack.second << "\n";
+		}
+		Manager::createNewFile(path, folded.str());
+	}
+
+}
+
+#endif
@@ -0,0 +1,72 @@
+
+#include "../Common/Header.hpp"
+
+#ifndef SPIN_PROFILER_HPP
+#define SPIN_PROFILER_HPP
+
+#include <atomic>
+#include <thread>
+
+#include "../Compiler/Program.hpp"
+#include "Encoding.hpp"
+#include "Frame.hpp"
+
+namespace Spin {
+
+	// Sampling profiler of the Processor: a thread
+	// raises a flag at every interval and the next
+	// safe point (calls and loops, see Collector.hpp)
+	// walks the records of the calls (see Frame.hpp)
+	// from the main code to the current routine. Samples
+	// are named after the routines of the Program and
+	// written in the folded format of flame graphs
+	// (one stack per line, root first, then the count).
+	// Straight code is only sampled at its next call,
+	// loop or at its callers, and native code (see
+	// Jit.hpp) isn't sampled at all.
+
+	class Profiler {
+
+		private:
+
+		std::atomic<Boolean> pending = false;
+		std::atomic<Boolean> running = false;
+		std::thread sampler;
+		UInt32 interval;
+
+		Dictionary<String, UInt64> stacks;
+
+		static String frame(Program * program, SizeType address);
+
+		public:
+
+		// Microseconds between two samples:
+		static constexpr UInt32 rate = 1000;
+
+		SizeType samples = 0;
+
+		Profiler(UInt32 interval = rate);
+		~Profiler();
+
+		Profiler(const Profiler &) = delete;
+		Profiler & operator = (const Profiler &) = delete;
+
+		void start();
+		void stop();
+
+		inline Boolean due() const {
+			return pending.load(std::memory_order_relaxed);
+		}
+
+		// Records of the calls, the outermost first:
+		void sample(Program * program, const Encoding & encoding,
+					const Frame * frames, SizeType count);
+
+		// Folded stacks:
+		void write(String path) const;
+
+	};
+
+}
+
+#endif
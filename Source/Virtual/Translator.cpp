@@ -0,0 +1,684 @@
+
+/*!
+ *
+ *    + --------------------------------------- +
+ *    |  Translator.cpp                         |
+ *    |                                         |
+ *    |           Register Translator           |
+ *    |                                         |
+ *    |  Created by Cristian A.                 |
+ *    |  Copyright © MIT. All rights reserved.  |
+ *    + --------------------------------------- +
+ *
+ *    Note: This software is licensed under
+ *          the (MIT) Massachusetts Institute
+ *          of Technology License.
+ *
+!*/
+
+#include "Translator.hpp"
+
+#ifndef SPIN_TRANSLATOR_CPP
+#define SPIN_TRANSLATOR_CPP
+
+#include <limits>
+
+#include "Operations.hpp"
+
+namespace Spin {
+
+	Machine::Code * Translator::translate(Program * program) {
+		if (!program || program -> instructions.empty()) return nullptr;
+		Translator translator;
+		translator.program = program;
+		translator.code = new Machine::Code();
+		translator.code -> program = program;
+		try {
+			translator.analyse();
+			translator.collect();
+			translator.translate();
+		} catch (Unsupported & u) {
+			delete translator.code;
+			return nullptr;
+		}
+		return translator.code;
+	}
+
+	// Analysis:
+
+	Int64 Translator::effect(SizeType i) {
+		const ByteCode & byte = program -> instructions[i];
+		const Value probe = { .integer = 1 };
+		const auto ignore = [] { };
+		Value result;
+		switch (byte.code) {
+			case OPCode::RST: case OPCode::SSF:
+			case OPCode::SET: case OPCode::SLF:
+			case OPCode::ICG: case OPCode::ICF:
+			case OPCode::JAF: case OPCode::JAT:
+			case OPCode::JMP: case OPCode::NOT:
+			case OPCode::RET: case OPCode::HLT: return 0;
+			case OPCode::PSH: case OPCode::STR:
+			case OPCode::TYP: case OPCode::ULA:
+			case OPCode::GET: case OPCode::GLF:
+			case OPCode::LTP: case OPCode::PST:
+			case OPCode::PSF: case OPCode::PSI:
+			case OPCode::PSU: case OPCode::DHD:
+			case OPCode::ADG: case OPCode::ADF: return 1;
+			case OPCode::GTT: case OPCode::GFT:
+			case OPCode::GTC: case OPCode::GFC: return 2;
+			case OPCode::LLA: case OPCode::CTP:
+			case OPCode::POP: case OPCode::JIF:
+			case OPCode::JIT: case OPCode::SEP:
+			case OPCode::SFP: return - 1;
+			case OPCode::SWP: return - 2;
+			case OPCode::DSK: return - (Int64)byte.as.index;
+			case OPCode::ADI: case OPCode::SBI: case OPCode::MLI:
+			case OPCode::DVI: case OPCode::MDI: case OPCode::ADR:
+			case OPCode::SBR: case OPCode::MLR: case OPCode::DVR:
+			case OPCode::EQI: case OPCode::NEI: case OPCode::GRI:
+			case OPCode::LSI: case OPCode::GEI: case OPCode::LEI:
+			case OPCode::EQR: case OPCode::NER: case OPCode::GRR:
+			case OPCode::LSR: case OPCode::GER: case OPCode::LER: return - 1;
+			case OPCode::JEQ: case OPCode::JNE: case OPCode::JGR:
+			case OPCode::JLS: case OPCode::JGE: case OPCode::JLE: return - 2;
+			// Only basic types are supported:
+			case OPCode::ADD: if (Operations::add(byte.as.types, probe, probe, result)) return - 1; break;
+			case OPCode::SUB: if (Operations::subtract(byte.as.types, probe, probe, result)) return - 1; break;
+			case OPCode::MUL: if (Operations::multiply(byte.as.types, probe, probe, result)) return - 1; break;
+			case OPCode::DIV: if (Operations::divide(byte.as.types, probe, probe, result, ignore)) return - 1; break;
+			case OPCode::MOD: if (Operations::modulo(byte.as.types, probe, probe, result, ignore)) return - 1; break;
+			case OPCode::EQL: if (Operations::equal(byte.as.types, probe, probe, result)) return - 1; break;
+			case OPCode::NEQ: if (Operations::different(byte.as.types, probe, probe, result)) return - 1; break;
+			case OPCode::GRT: if (Operations::greater(byte.as.types, probe, probe, result)) return - 1; break;
+			case OPCode::LSS: if (Operations::less(byte.as.types, probe, probe, result)) return - 1; break;
+			case OPCode::GEQ: if (Operations::greaterEqual(byte.as.types, probe, probe, result)) return - 1; break;
+			case OPCode::LEQ: if (Operations::lessEqual(byte.as.types, probe, probe, result)) return - 1; break;
+			case OPCode::BWA: if (Operations::bitwiseAnd(byte.as.types, probe, probe, result)) return - 1; break;
+			case OPCode::BWO: if (Operations::bitwiseOr(byte.as.types, probe, probe, result)) return - 1; break;
+			case OPCode::BWX: if (Operations::bitwiseXor(byte.as.types, probe, probe, result)) return - 1; break;
+			case OPCode::BSL: if (Operations::shiftLeft(byte.as.type, probe, probe, result)) return - 1; break;
+			case OPCode::BSR: if (Operations::shiftRight(byte.as.type, probe, probe, result)) return - 1; break;
+			case OPCode::BRL: if (Operations::rotateLeft(byte.as.type, probe, probe, result)) return - 1; break;
+			case OPCode::BRR: if (Operations::rotateRight(byte.as.type, probe, probe, result)) return - 1; break;
+			case OPCode::NEG: if (Operations::negate(byte.as.type, probe, result)) return 0; break;
+			case OPCode::CST: if (Operations::cast(byte.as.types, probe, result)) return 0; break;
+			// Calls always leave one value in place of
+			// their arguments (tail calls are run as calls
+			// here, the epilogue of their return follows):
+			case OPCode::CAL: case OPCode::LAM: case OPCode::TCL:
+				if (i == 0 || program -> instructions[i - 1].code != OPCode::SSF) break;
+				return 1 - (Int64)program -> instructions[i - 1].as.index;
+			case OPCode::INT:
+				switch ((Interrupt)byte.as.type) {
+					case Interrupt::write:
+					case Interrupt::writeln: return - 2;
+					case Interrupt::sleep: return - 1;
+					case Interrupt::clock:
+					case Interrupt::noise: return 1;
+					default: break;
+				}
+			break;
+			default: break;
+		}
+		throw Unsupported();
+	}
+
+	void Translator::analyse() {
+		// Every instruction gets the depth of the stack
+		// relative to the top of its frame at the entry
+		// of the routine, the main code starts from 0:
+		const SizeType size = program -> instructions.size();
+		depths = Array<Int64>(size, unknown);
+		regions = Array<SizeType>(size, Machine::none);
+		leaders = Array<Boolean>(size, false);
+		Array<Pair<SizeType, Int64>> work;
+		// Code following a return is either the body of
+		// a lamda or dead code, which falls into a block
+		// of its routine and is left untranslated:
+		class Dead { };
+		SizeType candidate = Machine::none;
+		const auto visit = [&] (SizeType i, Int64 d, SizeType region) {
+			if (i >= size) throw Unsupported();
+			if (depths[i] == unknown) {
+				depths[i] = d;
+				regions[i] = region;
+				work.push_back({ i, d });
+			} else if (depths[i] != d || regions[i] != region) {
+				if (region == candidate && regions[i] != region) throw Dead();
+				throw Unsupported();
+			}
+		};
+		const auto root = [&] (SizeType i) {
+			if (i >= size) throw Unsupported();
+			if (regions[i] == i) return;
+			leaders[i] = true;
+			visit(i, 0, i);
+		};
+		root(0);
+		SizeType start = 1;
+		while (true) {
+			try {
+				while (!work.empty()) {
+					const SizeType i = work.back().first;
+					const Int64 d = work.back().second;
+					work.pop_back();
+					const ByteCode & byte = program -> instructions[i];
+					const Int64 after = d + effect(i);
+					switch (byte.code) {
+						case OPCode::JMP:
+							leaders[byte.as.index] = true;
+							visit(byte.as.index, after, regions[i]);
+						break;
+						case OPCode::JIF: case OPCode::JIT:
+						case OPCode::JAF: case OPCode::JAT:
+						case OPCode::JEQ: case OPCode::JNE:
+						case OPCode::JGR: case OPCode::JLS:
+						case OPCode::JGE: case OPCode::JLE:
+							leaders[byte.as.index] = true;
+							visit(byte.as.index, after, regions[i]);
+							visit(i + 1, after, regions[i]);
+						break;
+						case OPCode::CAL: case OPCode::TCL: {
+							const Int64 n = program -> instructions[i - 1].as.index;
+							auto search = parameters.find(byte.as.index);
+							if (search == parameters.end()) {
+								parameters[byte.as.index] = n;
+							} else if (search -> second != n) throw Unsupported();
+							root(byte.as.index);
+							visit(i + 1, after, regions[i]);
+						} break;
+						case OPCode::RET: case OPCode::HLT: break;
+						default: visit(i + 1, after, regions[i]); break;
+					}
+				}
+			} catch (Dead &) {
+				for (SizeType i = 0; i < size; i += 1) {
+					if (regions[i] != candidate) continue;
+					depths[i] = unknown;
+					regions[i] = Machine::none;
+				}
+				std::erase_if(work, [&] (const Pair<SizeType, Int64> & item) {
+					return regions[item.first] == Machine::none;
+				});
+				start += 1;
+			}
+			// Lamdas are only reachable through their
+			// address, their bodies follow a return:
+			while (start < size) {
+				const OPCode previous = program -> instructions[start - 1].code;
+				if (depths[start] == unknown && (previous == OPCode::RET ||
+					previous == OPCode::HLT)) break;
+				start += 1;
+			}
+			if (start >= size) break;
+			candidate = start;
+			root(start);
+		}
+		// Every routine leaves its value in place of its
+		// parameters, so the depth of its returns gives
+		// away the number of parameters:
+		Dictionary<SizeType, Int64> returns;
+		SizeType deepest = 0;
+		for (SizeType i = 0; i < size; i += 1) {
+			if (depths[i] == unknown) continue;
+			if (depths[i] > (Int64)deepest) deepest = depths[i];
+			if (program -> instructions[i].code != OPCode::RET) continue;
+			if (regions[i] == 0) throw Unsupported();
+			const Int64 n = 1 - depths[i];
+			auto search = returns.find(regions[i]);
+			if (search == returns.end()) returns[regions[i]] = n;
+			else if (search -> second != n) throw Unsupported();
+		}
+		for (auto & routine : returns) {
+			auto search = parameters.find(routine.first);
+			if (search != parameters.end() && search -> second != routine.second) {
+				throw Unsupported();
+			}
+			parameters[routine.first] = routine.second;
+		}
+		for (SizeType i = 0; i < size; i += 1) {
+			if (depths[i] == unknown) continue;
+			if (regions[i] != 0 && parameters.find(regions[i]) == parameters.end()) {
+				throw Unsupported();
+			}
+			// A call and its frame are a single unit:
+			const OPCode code = program -> instructions[i].code;
+			if ((code == OPCode::CAL || code == OPCode::LAM ||
+				 code == OPCode::TCL) && leaders[i]) {
+				throw Unsupported();
+			}
+		}
+		parameters[0] = 0;
+		code -> reach = deepest + 4;
+	}
+
+	void Translator::collect() {
+		// Constants come before the main frame, so they
+		// all have to be known before translating:
+		code -> registers = Array<Value>(3, { .integer = 0 });
+		for (SizeType i = 0; i < program -> instructions.size(); i += 1) {
+			if (depths[i] == unknown) continue;
+			const ByteCode & byte = program -> instructions[i];
+			switch (byte.code) {
+				case OPCode::PSH: case OPCode::TYP: constant(byte.as.value); break;
+				case OPCode::STR: string(byte.as.index); break;
+				case OPCode::PST: constant(boolean(true)); break;
+				case OPCode::PSF: constant(boolean(false)); break;
+				case OPCode::PSI: constant({ .real = std::numeric_limits<Real>::infinity() }); break;
+				case OPCode::PSU: constant({ .real = std::numeric_limits<Real>::quiet_NaN() }); break;
+				case OPCode::GTC: case OPCode::GFC:
+				case OPCode::ICG: case OPCode::ICF:
+					constant({ .integer = (Int32)low(byte.as.index) });
+				break;
+				default: break;
+			}
+		}
+		globals = code -> registers.size();
+	}
+
+	// Registers:
+
+	Value Translator::boolean(Boolean value) {
+		Value constant = { .integer = 0 };
+		constant.boolean = value;
+		return constant;
+	}
+	UInt32 Translator::constant(Value value) {
+		auto search = constants.find((UInt64)value.integer);
+		if (search != constants.end()) return search -> second;
+		if (globals) throw Unsupported();
+		const UInt32 slot = Machine::global(code -> registers.size());
+		code -> registers.push_back(value);
+		constants[(UInt64)value.integer] = slot;
+		return slot;
+	}
+	UInt32 Translator::string(SizeType index) {
+		auto search = strings.find(index);
+		if (search != strings.end()) return search -> second;
+		if (globals || index >= program -> strings.size()) throw Unsupported();
+		// Strings are only ever written, so the
+		// register can hold the constant itself:
+		String * string = new String(program -> strings[index]);
+		code -> strings.push_back(string);
+		const UInt32 slot = Machine::global(code -> registers.size());
+		code -> registers.push_back({ .pointer = string });
+		strings[index] = slot;
+		return slot;
+	}
+	UInt32 Translator::global(SizeType index) {
+		// The main frame starts at the first global:
+		if (main) return Machine::local(index);
+		return Machine::global(globals + index);
+	}
+	UInt32 Translator::local(SizeType index) {
+		return Machine::local((Int64)index - frame);
+	}
+
+	// Emission:
+
+	void Translator::emit(Machine::Operation operation, UInt32 a, UInt32 b,
+						  UInt32 c, Types types) {
+		const Machine::Instruction instruction = {
+			.code = operation, .as = { .types = types },
+			.a = a, .b = b, .c = c
+		};
+		code -> instructions.push_back(instruction);
+		code -> addresses.push_back(index);
+		fresh = Machine::none;
+	}
+	void Translator::jump(Machine::Operation operation, SizeType target,
+						  UInt32 b, UInt32 c) {
+		fixups.push_back({ code -> instructions.size(), target });
+		emit(operation, 0, b, c);
+	}
+	void Translator::result(Machine::Operation operation, UInt32 b, UInt32 c,
+							Types types) {
+		const UInt32 slot = Machine::local(depth());
+		write(slot);
+		emit(operation, slot, b, c, types);
+		push(slot);
+		fresh = code -> instructions.size() - 1;
+	}
+
+	// Symbolic Stack:
+
+	Int64 Translator::depth() {
+		return bottom + (Int64)values.size();
+	}
+	void Translator::push(UInt32 value) {
+		values.push_back(value);
+	}
+	UInt32 Translator::pop() {
+		if (values.empty()) {
+			bottom -= 1;
+			return Machine::local(bottom);
+		}
+		const UInt32 value = values.back();
+		values.pop_back();
+		return value;
+	}
+	UInt32 Translator::peek() {
+		if (values.empty()) return Machine::local(bottom - 1);
+		return values.back();
+	}
+	void Translator::materialise(SizeType k) {
+		const UInt32 slot = Machine::local(bottom + (Int64)k);
+		if (values[k] == slot) return;
+		emit(Machine::MOV, slot, values[k]);
+		values[k] = slot;
+	}
+	void Translator::flush() {
+		for (SizeType k = 0; k < values.size(); k += 1) materialise(k);
+		bottom = depth();
+		values.clear();
+	}
+	UInt32 Translator::read(UInt32 slot) {
+		// A slot of the frame still waiting for its value:
+		if (!(slot & Machine::absolute)) {
+			const Int64 offset = (Int32)(slot << 1) >> 1;
+			if (offset >= bottom && offset < depth()) {
+				materialise(offset - bottom);
+			}
+		}
+		return slot;
+	}
+	void Translator::write(UInt32 slot) {
+		// Every value still reading the slot needs its
+		// own copy before the slot is overwritten:
+		for (SizeType k = 0; k < values.size(); k += 1) {
+			if (values[k] == slot) materialise(k);
+		}
+	}
+	void Translator::settle(UInt32 slot) {
+		if (!(slot & Machine::absolute)) {
+			const Int64 offset = (Int32)(slot << 1) >> 1;
+			if (offset >= bottom && offset < depth()) {
+				values[offset - bottom] = slot;
+			}
+		}
+	}
+	Boolean Translator::store(UInt32 slot, UInt32 value, Boolean peeked) {
+		if (slot == value) return false;
+		const SizeType last = fresh;
+		write(slot);
+		// The last operation can write its result in
+		// place if nothing has been emitted since:
+		Boolean unique = true;
+		const SizeType live = values.size() - (peeked && !values.empty());
+		for (SizeType k = 0; k < live; k += 1) {
+			if (values[k] == value) unique = false;
+		}
+		if (last != Machine::none && fresh == last && unique &&
+			code -> instructions[last].a == value) {
+			code -> instructions[last].a = slot;
+			settle(slot);
+			fresh = Machine::none;
+			return true;
+		}
+		emit(Machine::MOV, slot, value);
+		settle(slot);
+		return false;
+	}
+
+	// Translation:
+
+	void Translator::translate() {
+		const SizeType size = program -> instructions.size();
+		code -> entries = Array<UInt32>(size, Machine::none);
+		Boolean falls = false;
+		for (SizeType i = 0; i < size; ) {
+			if (depths[i] == unknown) {
+				if (falls) throw Unsupported();
+				i += 1; continue;
+			}
+			if (leaders[i]) {
+				if (falls) flush();
+				values.clear();
+				bottom = depths[i];
+				fresh = Machine::none;
+				main = regions[i] == 0;
+				frame = parameters[regions[i]];
+				code -> entries[i] = code -> instructions.size();
+			}
+			translate(i);
+			const OPCode last = program -> instructions[i - 1].code;
+			falls = last != OPCode::JMP && last != OPCode::RET &&
+					last != OPCode::HLT;
+		}
+		if (falls) {
+			index = size - 1;
+			emit(Machine::HLT);
+		}
+		for (auto & fixup : fixups) {
+			const UInt32 target = code -> entries[fixup.second];
+			if (target == Machine::none) throw Unsupported();
+			code -> instructions[fixup.first].a = target;
+		}
+	}
+
+	void Translator::translate(SizeType & i) {
+		const ByteCode & byte = program -> instructions[i];
+		index = i;
+		i += 1;
+		switch (byte.code) {
+			case OPCode::RST: case OPCode::SSF: break;
+			case OPCode::PSH:
+			case OPCode::TYP: push(constant(byte.as.value)); break;
+			case OPCode::STR: push(string(byte.as.index)); break;
+			case OPCode::PST: push(constant(boolean(true))); break;
+			case OPCode::PSF: push(constant(boolean(false))); break;
+			case OPCode::PSI: push(constant({ .real = std::numeric_limits<Real>::infinity() })); break;
+			case OPCode::PSU: push(constant({ .real = std::numeric_limits<Real>::quiet_NaN() })); break;
+			case OPCode::LLA: store(lamda, pop()); break;
+			case OPCode::ULA: push(lamda); break;
+			case OPCode::GET: push(read(global(byte.as.index))); break;
+			case OPCode::GLF: push(read(local(byte.as.index))); break;
+			case OPCode::SET:
+			case OPCode::SLF: {
+				const UInt32 slot = byte.code == OPCode::SET ?
+									global(byte.as.index) :
+									local(byte.as.index);
+				if (store(slot, peek(), true) && !values.empty()) {
+					values.back() = slot;
+				}
+			} break;
+			case OPCode::SEP: store(global(byte.as.index), pop()); break;
+			case OPCode::SFP: store(local(byte.as.index), pop()); break;
+			case OPCode::CTP: {
+				// Returning a value from a function:
+				SizeType j = i;
+				const auto skip = [&] (OPCode code) {
+					if (j < program -> instructions.size() && !leaders[j] &&
+						program -> instructions[j].code == code) {
+						j += 1; return true;
+					}
+					return false;
+				};
+				if (!skip(OPCode::POP)) skip(OPCode::DSK);
+				if (skip(OPCode::LTP) && skip(OPCode::RET)) {
+					emit(Machine::RET, Machine::local(- frame), pop());
+					index = j - 1; i = j;
+					break;
+				}
+				store(temporary, pop());
+			} break;
+			case OPCode::LTP: push(temporary); break;
+			case OPCode::SWP: {
+				const UInt32 b = pop(), a = pop();
+				const SizeType first = a & ~Machine::absolute;
+				const SizeType second = b & ~Machine::absolute;
+				if (!(a & Machine::absolute) || !(b & Machine::absolute) ||
+					first < 3 || second < 3 || first >= globals ||
+					second >= globals) throw Unsupported();
+				const UInt32 x = read(global(code -> registers[first].integer));
+				const UInt32 y = read(global(code -> registers[second].integer));
+				store(swap, x);
+				store(x, y);
+				store(y, swap);
+			} break;
+			case OPCode::POP: pop(); break;
+			case OPCode::DHD: push(peek()); break;
+			case OPCode::DSK:
+				for (SizeType k = 0; k < byte.as.index; k += 1) pop();
+			break;
+			case OPCode::JMP: flush(); jump(Machine::JMP, byte.as.index); break;
+			case OPCode::JIF:
+			case OPCode::JIT: {
+				const UInt32 condition = pop();
+				flush();
+				jump(
+					byte.code == OPCode::JIF ? Machine::JIF : Machine::JIT,
+					byte.as.index, condition
+				);
+			} break;
+			case OPCode::JAF:
+			case OPCode::JAT:
+				flush();
+				jump(
+					byte.code == OPCode::JAF ? Machine::JIF : Machine::JIT,
+					byte.as.index, Machine::local(depth() - 1)
+				);
+			break;
+			case OPCode::JEQ: case OPCode::JNE: case OPCode::JGR:
+			case OPCode::JLS: case OPCode::JGE: case OPCode::JLE: {
+				const UInt32 c = pop(), b = pop();
+				flush();
+				Machine::Operation operation = Machine::JEQ;
+				switch (byte.code) {
+					case OPCode::JNE: operation = Machine::JNE; break;
+					case OPCode::JGR: operation = Machine::JGR; break;
+					case OPCode::JLS: operation = Machine::JLS; break;
+					case OPCode::JGE: operation = Machine::JGE; break;
+					case OPCode::JLE: operation = Machine::JLE; break;
+					default: break;
+				}
+				jump(operation, byte.as.index, b, c);
+			} break;
+			case OPCode::NOT: result(Machine::NOT, pop()); break;
+			case OPCode::NEG: result(Machine::NEG, pop(), 0, byte.as.types); break;
+			case OPCode::CST: result(Machine::CST, pop(), 0, byte.as.types); break;
+			case OPCode::ADD: case OPCode::SUB: case OPCode::MUL:
+			case OPCode::DIV: case OPCode::MOD: case OPCode::EQL:
+			case OPCode::NEQ: case OPCode::GRT: case OPCode::LSS:
+			case OPCode::GEQ: case OPCode::LEQ: case OPCode::BWA:
+			case OPCode::BWO: case OPCode::BWX: case OPCode::BSR:
+			case OPCode::BSL: case OPCode::BRR: case OPCode::BRL:
+			case OPCode::ADI: case OPCode::SBI: case OPCode::MLI:
+			case OPCode::DVI: case OPCode::MDI: case OPCode::ADR:
+			case OPCode::SBR: case OPCode::MLR: case OPCode::DVR:
+			case OPCode::EQI: case OPCode::NEI: case OPCode::GRI:
+			case OPCode::LSI: case OPCode::GEI: case OPCode::LEI:
+			case OPCode::EQR: case OPCode::NER: case OPCode::GRR:
+			case OPCode::LSR: case OPCode::GER: case OPCode::LER: {
+				static const Dictionary<UInt8, Machine::Operation> table = {
+					{ OPCode::ADD, Machine::ADD }, { OPCode::SUB, Machine::SUB },
+					{ OPCode::MUL, Machine::MUL }, { OPCode::DIV, Machine::DIV },
+					{ OPCode::MOD, Machine::MOD }, { OPCode::EQL, Machine::EQL },
+					{ OPCode::NEQ, Machine::NEQ }, { OPCode::GRT, Machine::GRT },
+					{ OPCode::LSS, Machine::LSS }, { OPCode::GEQ, Machine::GEQ },
+					{ OPCode::LEQ, Machine::LEQ }, { OPCode::BWA, Machine::BWA },
+					{ OPCode::BWO, Machine::BWO }, { OPCode::BWX, Machine::BWX },
+					{ OPCode::BSR, Machine::BSR }, { OPCode::BSL, Machine::BSL },
+					{ OPCode::BRR, Machine::BRR }, { OPCode::BRL, Machine::BRL },
+					{ OPCode::ADI, Machine::ADI }, { OPCode::SBI, Machine::SBI },
+					{ OPCode::MLI, Machine::MLI }, { OPCode::DVI, Machine::DVI },
+					{ OPCode::MDI, Machine::MDI }, { OPCode::ADR, Machine::ADR },
+					{ OPCode::SBR, Machine::SBR }, { OPCode::MLR, Machine::MLR },
+					{ OPCode::DVR, Machine::DVR }, { OPCode::EQI, Machine::EQI },
+					{ OPCode::NEI, Machine::NEI }, { OPCode::GRI, Machine::GRI },
+					{ OPCode::LSI, Machine::LSI }, { OPCode::GEI, Machine::GEI },
+					{ OPCode::LEI, Machine::LEI }, { OPCode::EQR, Machine::EQR },
+					{ OPCode::NER, Machine::NER }, { OPCode::GRR, Machine::GRR },
+					{ OPCode::LSR, Machine::LSR }, { OPCode::GER, Machine::GER },
+					{ OPCode::LER, Machine::LER },
+				};
+				const UInt32 c = pop(), b = pop();
+				result(table.at(byte.code), b, c, byte.as.types);
+			} break;
+			// Superinstructions:
+			case OPCode::GTT:
+				push(read(global(high(byte.as.index))));
+				push(read(global(low(byte.as.index))));
+			break;
+			case OPCode::GFT:
+				push(read(local(high(byte.as.index))));
+				push(read(local(low(byte.as.index))));
+			break;
+			case OPCode::GTC:
+				push(read(global(high(byte.as.index))));
+				push(constant({ .integer = (Int32)low(byte.as.index) }));
+			break;
+			case OPCode::GFC:
+				push(read(local(high(byte.as.index))));
+				push(constant({ .integer = (Int32)low(byte.as.index) }));
+			break;
+			case OPCode::ADG:
+				result(
+					Machine::ADI,
+					read(global(high(byte.as.index))),
+					read(global(low(byte.as.index)))
+				);
+			break;
+			case OPCode::ADF:
+				result(
+					Machine::ADI,
+					read(local(high(byte.as.index))),
+					read(local(low(byte.as.index)))
+				);
+			break;
+			case OPCode::ICG:
+			case OPCode::ICF: {
+				const UInt32 slot = byte.code == OPCode::ICG ?
+									global(high(byte.as.index)) :
+									local(high(byte.as.index));
+				read(slot);
+				write(slot);
+				emit(
+					Machine::ADI, slot, slot,
+					constant({ .integer = (Int32)low(byte.as.index) })
+				);
+				settle(slot);
+			} break;
+			// Calls:
+			case OPCode::CAL:
+			case OPCode::TCL:
+			case OPCode::LAM: {
+				const Int64 n = program -> instructions[i - 2].as.index;
+				const Int64 d = depth();
+				flush();
+				if (byte.code != OPCode::LAM) {
+					jump(Machine::CAL, byte.as.index, (UInt32)d);
+				} else emit(Machine::LAM, lamda, (UInt32)d);
+				values.clear();
+				bottom = d - n;
+				push(Machine::local(bottom));
+			} break;
+			case OPCode::RET: emit(Machine::RET, Machine::local(- frame), pop()); break;
+			case OPCode::INT:
+				switch ((Interrupt)byte.as.type) {
+					case Interrupt::write:
+					case Interrupt::writeln: {
+						const UInt32 type = pop();
+						const UInt32 value = pop();
+						emit(Machine::INT, 0, value, type, byte.as.types);
+					} break;
+					case Interrupt::sleep:
+						emit(Machine::INT, 0, pop(), 0, byte.as.types);
+					break;
+					default: {
+						const UInt32 slot = Machine::local(depth());
+						write(slot);
+						emit(Machine::INT, slot, 0, 0, byte.as.types);
+						push(slot);
+					} break;
+				}
+			break;
+			case OPCode::HLT: emit(Machine::HLT); break;
+			default: throw Unsupported();
+		}
+	}
+
+}
+
+#endif
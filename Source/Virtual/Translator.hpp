@@ -0,0 +1,96 @@
+
+#include "../Common/Header.hpp"
+
+#ifndef SPIN_TRANSLATOR_HPP
+#define SPIN_TRANSLATOR_HPP
+
+#include "Machine.hpp"
+
+namespace Spin {
+
+	// Translates the stack code of a compiled program
+	// into register code for the Machine. Values that
+	// the stack code would push are kept symbolic and
+	// only written into their frame slot at the end of
+	// a block, before a call, or when something would
+	// overwrite their source. Programs using objects,
+	// native calls or input can't be translated and
+	// must run on the Processor.
+
+	class Translator {
+
+		private:
+
+		class Unsupported { };
+
+		static constexpr Int64 unknown = INT64_MIN;
+
+		// Absolute registers for the temporary copy, the
+		// lamda address and the swap statement:
+		static constexpr UInt32 temporary = Machine::global(0);
+		static constexpr UInt32 lamda = Machine::global(1);
+		static constexpr UInt32 swap = Machine::global(2);
+
+		Program * program = nullptr;
+		Machine::Code * code = nullptr;
+		SizeType index = 0;
+
+		// Analysis:
+		Array<Int64> depths;
+		Array<SizeType> regions;
+		Array<Boolean> leaders;
+		Dictionary<SizeType, Int64> parameters;
+		SizeType globals = 0;
+
+		// Symbolic stack of the current block:
+		Array<UInt32> values;
+		Int64 bottom = 0;
+		Int64 frame = 0;
+		Boolean main = true;
+		SizeType fresh = Machine::none;
+
+		Dictionary<UInt64, UInt32> constants;
+		Dictionary<SizeType, UInt32> strings;
+		Array<Pair<SizeType, SizeType>> fixups;
+
+		Translator() = default;
+
+		Int64 effect(SizeType i);
+		void analyse();
+		void collect();
+		void translate();
+		void translate(SizeType & i);
+
+		static Value boolean(Boolean value);
+		UInt32 constant(Value value);
+		UInt32 string(SizeType index);
+		UInt32 global(SizeType index);
+		UInt32 local(SizeType index);
+
+		void emit(Machine::Operation operation, UInt32 a = 0, UInt32 b = 0,
+				  UInt32 c = 0, Types types = 0);
+		void jump(Machine::Operation operation, SizeType target,
+				  UInt32 b = 0, UInt32 c = 0);
+		void result(Machine::Operation operation, UInt32 b, UInt32 c = 0,
+					Types types = 0);
+
+		Int64 depth();
+		void push(UInt32 value);
+		UInt32 pop();
+		UInt32 peek();
+		void materialise(SizeType k);
+		void flush();
+		UInt32 read(UInt32 slot);
+		void write(UInt32 slot);
+		void settle(UInt32 slot);
+		Boolean store(UInt32 slot, UInt32 value, Boolean peeked = false);
+
+		public:
+
+		static Machine::Code * translate(Program * program);
+
+	};
+
+}
+
+#endif
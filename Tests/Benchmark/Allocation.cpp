@@ -0,0 +1,105 @@
+
+/*!
+ *
+ *    + --------------------------------------- +
+ *    |  Allocation.cpp                         |
+ *    |                                         |
+ *    |          Allocation Benchmark           |
+ *    |                                         |
+ *    |  Created by Cristian A.                 |
+ *    |  Copyright © MIT. All rights reserved.  |
+ *    + --------------------------------------- +
+ *
+ *    Note: This software is licensed under
+ *          the (MIT) Massachusetts Institute
+ *          of Technology License.
+ *
+!*/
+
+#include "../../Source/Common/Interface.hpp"
+
+#include "../../Source/Compiler/Program.hpp"
+#include "../../Source/Types/Complex.hpp"
+#include "../../Source/Utility/Pool.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Spin;
+
+// Allocates the objects of many short runs through
+// the old registry of the Processor (new, a vector
+// of objects and a delete for each one at the end)
+// and through a Pool (bump and reset), then reports
+// the time of both for every kind of object.
+
+const SizeType rounds = 64;
+const SizeType objects = 65536;
+
+template <typename Make>
+UInt64 registry(Type type, Make make) {
+	Array<Pair<Pointer, Type>> registry;
+	Timer::start();
+	for (SizeType r = 0; r < rounds; r += 1) {
+		for (SizeType i = 0; i < objects; i += 1) {
+			registry.push_back({ make(i), type });
+		}
+		for (auto & object : registry) {
+			switch (object.second) {
+				case Type::ComplexType: delete ((Complex *)object.first); break;
+				case  Type::StringType: delete ((String *)object.first); break;
+				case   Type::ArrayType: delete ((Array<Value> *)object.first); break;
+				default: break;
+			}
+		}
+		registry.clear();
+	}
+	Timer::stop();
+	return Timer::time;
+}
+
+template <typename Object, typename Make>
+UInt64 pool(Make make) {
+	Pool<Object> pool;
+	Timer::start();
+	for (SizeType r = 0; r < rounds; r += 1) {
+		for (SizeType i = 0; i < objects; i += 1) make(pool, i);
+		pool.reset();
+	}
+	Timer::stop();
+	return Timer::time;
+}
+
+Int32 main() {
+
+	const UInt64 complexRegistry = registry(Type::ComplexType, [] (SizeType i) {
+		return (Pointer) new Complex((Real) i, 1.0);
+	});
+	const UInt64 complexPool = pool<Complex>([] (Pool<Complex> & pool, SizeType i) {
+		pool.make((Real) i, 1.0);
+	});
+
+	const UInt64 stringRegistry = registry(Type::StringType, [] (SizeType) {
+		return (Pointer) new String("spin");
+	});
+	const UInt64 stringPool = pool<String>([] (Pool<String> & pool, SizeType) {
+		pool.make("spin");
+	});
+
+	const UInt64 arrayRegistry = registry(Type::ArrayType, [] (SizeType) {
+		return (Pointer) new Array<Value>();
+	});
+	const UInt64 arrayPool = pool<Array<Value>>([] (Pool<Array<Value>> & pool, SizeType) {
+		pool.make();
+	});
+
+	OStream << endLine << "% BMK Allocation Benchmark %" << endLine
+			<< rounds << " runs of " << objects << " objects each:" << endLine
+			<< "Complex: registry " << complexRegistry << "ms, pool "
+			<< complexPool << "ms." << endLine
+			<< "String: registry " << stringRegistry << "ms, pool "
+			<< stringPool << "ms." << endLine
+			<< "Array: registry " << arrayRegistry << "ms, pool "
+			<< arrayPool << "ms." << endLine << endLine;
+
+	return ExitCodes::success;
+}
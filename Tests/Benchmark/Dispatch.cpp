@@ -0,0 +1,113 @@
+
+/*!
+ *
+ *    + --------------------------------------- +
+ *    |  Dispatch.cpp                           |
+ *    |                                         |
+ *    |           Dispatch Benchmark            |
+ *    |                                         |
+ *    |  Created by Cristian A.                 |
+ *    |  Copyright © MIT. All rights reserved.  |
+ *    + --------------------------------------- +
+ *
+ *    Note: This software is licensed under
+ *          the (MIT) Massachusetts Institute
+ *          of Technology License.
+ *
+!*/
+
+#include "../../Source/Common/Interface.hpp"
+
+#include "../../Source/Manager/Manager.hpp"
+#include "../../Source/Preprocessor/Wings.hpp"
+#include "../../Source/Compiler/Compiler.hpp"
+#include "../../Source/Compiler/Verifier.hpp"
+#include "../../Source/Virtual/Processor.hpp"
+#include "../../Source/Utility/Serialiser.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Spin;
+
+// Runs every program a fixed number of times and reports
+// the average execution time. Build.ninja links this file
+// twice: 'Dispatch' with threaded code, 'PortableDispatch'
+// with the switch fallback, to compare the two modes.
+
+const SizeType runs = 5;
+
+Program * load(String path) {
+	if (path.ends_with(".sexy")) return Program::from(path);
+	SourceCode * code = Wings::spread(path);
+	Program * program = Compiler::self() -> compile(code);
+	delete code;
+	return program;
+}
+
+Int32 main(Int32 argc, Character * argv[]) {
+
+	if (argc < 2) {
+		OStream << endLine << "% BMK Dispatch Benchmark %" << endLine
+				<< "Usage: Dispatch <file.spin | file.sexy> ..."
+				<< endLine << endLine;
+		return ExitCodes::failure;
+	}
+
+	Processor * processor = Processor::self();
+
+	Array<Pair<String, UInt64>> results;
+
+	for (Int32 i = 1; i < argc; i += 1) {
+		const String path = argv[i];
+		Program * program = nullptr;
+		try { program = load(path); }
+		catch (Program::Error & e) {
+			OStream << endLine << "% " << e.getErrorCode()
+					<< " Error on line " << e.getLine() << " of ['"
+					<< e.getFile() << "'] %" << endLine
+					<< e.getMessage() << endLine << endLine;
+			return ExitCodes::failure;
+		} catch (Manager::BadFileException & b) {
+			OStream << endLine << "% SYS Catastrophic Event %" << endLine
+					<< "Couldn't open or read file ['" << b.getPath()
+					<< "']!" << endLine << endLine;
+			return ExitCodes::failure;
+		} catch (Serialiser::ReadingError & r) {
+			OStream << endLine << "% PPR Catastrophic Event %" << endLine
+					<< "Couldn't read invalid file ['" << path
+					<< "']!" << endLine << endLine;
+			return ExitCodes::failure;
+		} catch (Verifier::Error & e) {
+			OStream << endLine << "% VRF Error on address [" << e.getAddress()
+					<< "] %" << endLine << e.getMessage() << endLine << endLine;
+			return ExitCodes::failure;
+		}
+		UInt64 total = 0;
+		for (SizeType r = 0; r < runs; r += 1) {
+			Timer::start();
+			try { processor -> run(program); }
+			catch (Processor::Crash & c) {
+				OStream << endLine << "% EVL Error on address [0x"
+						<< hexadecimal << padding(8) << c.getAddress()
+						<< "] %" << decimal << endLine << endLine;
+				delete program;
+				return ExitCodes::failure;
+			}
+			Timer::stop();
+			total += Timer::time;
+		}
+		results.push_back({ path, total / runs });
+		delete program;
+	}
+
+	OStream << endLine << "% BMK Dispatch Benchmark ("
+			<< (Processor::threaded ? "threaded" : "switch")
+			<< ") %" << endLine;
+	for (auto & result : results) {
+		OStream << result.first << ": " << result.second
+				<< "ms (average of " << runs << " runs)." << endLine;
+	}
+	OStream << endLine;
+
+	return ExitCodes::success;
+}
@@ -0,0 +1,137 @@
+
+/*!
+ *
+ *    + --------------------------------------- +
+ *    |  Registers.cpp                          |
+ *    |                                         |
+ *    |           Registers Benchmark           |
+ *    |                                         |
+ *    |  Created by Cristian A.                 |
+ *    |  Copyright © MIT. All rights reserved.  |
+ *    + --------------------------------------- +
+ *
+ *    Note: This software is licensed under
+ *          the (MIT) Massachusetts Institute
+ *          of Technology License.
+ *
+!*/
+
+#include "../../Source/Common/Interface.hpp"
+
+#include "../../Source/Manager/Manager.hpp"
+#include "../../Source/Preprocessor/Wings.hpp"
+#include "../../Source/Compiler/Compiler.hpp"
+#include "../../Source/Compiler/Verifier.hpp"
+#include "../../Source/Virtual/Processor.hpp"
+#include "../../Source/Virtual/Translator.hpp"
+#include "../../Source/Utility/Serialiser.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Spin;
+
+// Runs every program on both engines and reports the
+// size of the code and the average execution time of
+// the stack processor and of the register machine.
+
+const SizeType runs = 5;
+
+Program * load(String path) {
+	if (path.ends_with(".sexy")) return Program::from(path);
+	SourceCode * code = Wings::spread(path);
+	Program * program = Compiler::self() -> compile(code);
+	delete code;
+	return program;
+}
+
+struct Result {
+	String path;
+	SizeType stack = 0, registers = 0;
+	UInt64 processor = 0, machine = 0;
+};
+
+Int32 main(Int32 argc, Character * argv[]) {
+
+	if (argc < 2) {
+		OStream << endLine << "% BMK Registers Benchmark %" << endLine
+				<< "Usage: Registers <file.spin | file.sexy> ..."
+				<< endLine << endLine;
+		return ExitCodes::failure;
+	}
+
+	Processor * processor = Processor::self();
+	Machine * machine = Machine::self();
+
+	Array<Result> results;
+
+	for (Int32 i = 1; i < argc; i += 1) {
+		Result result = { argv[i] };
+		Program * program = nullptr;
+		try { program = load(result.path); }
+		catch (Program::Error & e) {
+			OStream << endLine << "% " << e.getErrorCode()
+					<< " Error on line " << e.getLine() << " of ['"
+					<< e.getFile() << "'] %" << endLine
+					<< e.getMessage() << endLine << endLine;
+			return ExitCodes::failure;
+		} catch (Manager::BadFileException & b) {
+			OStream << endLine << "% SYS Catastrophic Event %" << endLine
+					<< "Couldn't open or read file ['" << b.getPath()
+					<< "']!" << endLine << endLine;
+			return ExitCodes::failure;
+		} catch (Serialiser::ReadingError & r) {
+			OStream << endLine << "% PPR Catastrophic Event %" << endLine
+					<< "Couldn't read invalid file ['" << result.path
+					<< "']!" << endLine << endLine;
+			return ExitCodes::failure;
+		} catch (Verifier::Error & e) {
+			OStream << endLine << "% VRF Error on address [" << e.getAddress()
+					<< "] %" << endLine << e.getMessage() << endLine << endLine;
+			return ExitCodes::failure;
+		}
+		Machine::Code * code = Translator::translate(program);
+		result.stack = program -> instructions.size();
+		if (code) result.registers = code -> instructions.size();
+		try {
+			for (SizeType r = 0; r < runs; r += 1) {
+				Timer::start();
+				processor -> run(program);
+				Timer::stop();
+				result.processor += Timer::time;
+				if (!code) continue;
+				Timer::start();
+				machine -> run(code);
+				Timer::stop();
+				result.machine += Timer::time;
+			}
+		} catch (Processor::Crash & c) {
+			OStream << endLine << "% EVL Error on address [0x"
+					<< hexadecimal << padding(8) << c.getAddress()
+					<< "] %" << decimal << endLine << endLine;
+			if (code) delete code;
+			delete program;
+			return ExitCodes::failure;
+		}
+		result.processor /= runs;
+		result.machine /= runs;
+		results.push_back(result);
+		if (code) delete code;
+		delete program;
+	}
+
+	OStream << endLine << "% BMK Registers Benchmark %" << endLine;
+	for (auto & result : results) {
+		OStream << result.path << ": " << result.stack
+				<< " stack instructions, " << result.processor << "ms";
+		if (result.registers) {
+			OStream << "; " << result.registers
+					<< " register instructions, " << result.machine
+					<< "ms (average of " << runs << " runs)." << endLine;
+		} else {
+			OStream << "; can't be translated into registers." << endLine;
+		}
+	}
+	OStream << endLine;
+
+	return ExitCodes::success;
+}
@@ -0,0 +1,162 @@
+
+/*!
+ *
+ *    + --------------------------------------- +
+ *    |  Grams.cpp                              |
+ *    |                                         |
+ *    |              N-Gram Mining              |
+ *    |                                         |
+ *    |  Created by Cristian A.                 |
+ *    |  Copyright © MIT. All rights reserved.  |
+ *    + --------------------------------------- +
+ *
+ *    Note: This software is licensed under
+ *          the (MIT) Massachusetts Institute
+ *          of Technology License.
+ *
+!*/
+
+#include "../../Source/Common/Interface.hpp"
+
+#include "../../Source/Manager/Manager.hpp"
+#include "../../Source/Preprocessor/Wings.hpp"
+#include "../../Source/Compiler/Compiler.hpp"
+#include "../../Source/Compiler/Verifier.hpp"
+#include "../../Source/Compiler/Decompiler.hpp"
+#include "../../Source/Utility/Serialiser.hpp"
+
+#include <algorithm>
+
+using namespace Spin;
+
+// Counts the most frequent opcode sequences in a corpus of
+// programs. A sequence never crosses a jump target and it
+// never continues after a control transfer, so that every
+// sequence in the report could become a superinstruction.
+// Run it on the corpus and update the fused opcodes of the
+// superinstruction pass (Compiler::fuse) with the sequences
+// on top. Compiled '.sexy' files should be compiled with
+// the superinstructions turned off.
+
+const SizeType shortest = 2;
+const SizeType longest = 4;
+const SizeType shown = 16;
+
+Program * load(String path) {
+	if (path.ends_with(".sexy")) return Program::from(path);
+	SourceCode * code = Wings::spread(path);
+	// Superinstructions would hide the sequences:
+	Compiler::Options options;
+	options.fusing = false;
+	Program * program = Compiler::self() -> compile(code, options);
+	delete code;
+	return program;
+}
+
+Boolean transfers(OPCode code) {
+	switch (code) {
+		case OPCode::JMP: case OPCode::JIF:
+		case OPCode::JAF: case OPCode::JIT:
+		case OPCode::JAT: case OPCode::JEQ:
+		case OPCode::JNE: case OPCode::JGR:
+		case OPCode::JLS: case OPCode::JGE:
+		case OPCode::JLE: case OPCode::CAL:
+		case OPCode::LAM: case OPCode::RET:
+		case OPCode::HLT: case OPCode::RST:
+		case OPCode::TCL:
+			return true;
+		default: return false;
+	}
+}
+
+Boolean jumps(OPCode code) {
+	return transfers(code) && code != OPCode::LAM &&
+		   code != OPCode::RET && code != OPCode::HLT &&
+		   code != OPCode::RST;
+}
+
+void mine(Program * program, Dictionary<String, UInt64> & grams) {
+	const SizeType size = program -> instructions.size();
+	Array<Boolean> leaders(size + 1, false);
+	for (ByteCode & byte : program -> instructions) {
+		if (jumps(byte.code) && byte.as.index < size) {
+			leaders[byte.as.index] = true;
+		}
+	}
+	for (SizeType i = 0; i < size; i += 1) {
+		String gram = Decompiler::mnemonic(program -> instructions[i].code);
+		for (SizeType n = 1; n < longest && i + n < size; n += 1) {
+			if (transfers(program -> instructions[i + n - 1].code)) break;
+			if (leaders[i + n]) break;
+			gram += " " + Decompiler::mnemonic(program -> instructions[i + n].code);
+			if (n + 1 >= shortest) grams[gram] += 1;
+		}
+	}
+}
+
+Int32 main(Int32 argc, Character * argv[]) {
+
+	if (argc < 2) {
+		OStream << endLine << "% N-Gram Mining %" << endLine
+				<< "Usage: Grams <file.spin | file.sexy> ..."
+				<< endLine << endLine;
+		return ExitCodes::failure;
+	}
+
+	Dictionary<String, UInt64> grams;
+	UInt64 instructions = 0;
+
+	for (Int32 i = 1; i < argc; i += 1) {
+		const String path = argv[i];
+		Program * program = nullptr;
+		try { program = load(path); }
+		catch (Program::Error & e) {
+			OStream << endLine << "% " << e.getErrorCode()
+					<< " Error on line " << e.getLine() << " of ['"
+					<< e.getFile() << "'] %" << endLine
+					<< e.getMessage() << endLine << endLine;
+			return ExitCodes::failure;
+		} catch (Manager::BadFileException & b) {
+			OStream << endLine << "% SYS Catastrophic Event %" << endLine
+					<< "Couldn't open or read file ['" << b.getPath()
+					<< "']!" << endLine << endLine;
+			return ExitCodes::failure;
+		} catch (Serialiser::ReadingError & r) {
+			OStream << endLine << "% PPR Catastrophic Event %" << endLine
+					<< "Couldn't read invalid file ['" << path
+					<< "']!" << endLine << endLine;
+			return ExitCodes::failure;
+		} catch (Verifier::Error & e) {
+			OStream << endLine << "% VRF Error on address [" << e.getAddress()
+					<< "] %" << endLine << e.getMessage() << endLine << endLine;
+			return ExitCodes::failure;
+		}
+		if (!program) continue;
+		instructions += program -> instructions.size();
+		mine(program, grams);
+		delete program;
+	}
+
+	OStream << endLine << "% N-Gram Mining (" << instructions
+			<< " instructions) %" << endLine;
+	for (SizeType n = shortest; n <= longest; n += 1) {
+		Array<Pair<String, UInt64>> ranking;
+		for (auto & gram : grams) {
+			// Every mnemonic is 3 characters plus a space:
+			if ((gram.first.length() + 1) / 4 != n) continue;
+			ranking.push_back(gram);
+		}
+		std::sort(ranking.begin(), ranking.end(),
+			[] (auto & a, auto & b) { return a.second > b.second; }
+		);
+		if (ranking.size() > shown) ranking.resize(shown);
+		OStream << endLine << n << "-grams:" << endLine;
+		for (auto & gram : ranking) {
+			OStream << "    " << gram.first << "    "
+					<< gram.second << endLine;
+		}
+	}
+	OStream << endLine;
+
+	return ExitCodes::success;
+}
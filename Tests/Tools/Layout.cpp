@@ -0,0 +1,218 @@
+
+/*!
+ *
+ *    + --------------------------------------- +
+ *    |  Layout.cpp                             |
+ *    |                                         |
+ *    |             Bytecode Layout             |
+ *    |                                         |
+ *    |  Created by Cristian A.                 |
+ *    |  Copyright © MIT. All rights reserved.  |
+ *    + --------------------------------------- +
+ *
+ *    Note: This software is licensed under
+ *          the (MIT) Massachusetts Institute
+ *          of Technology License.
+ *
+!*/
+
+#include "../../Source/Common/Interface.hpp"
+
+#include "../../Source/Manager/Manager.hpp"
+#include "../../Source/Preprocessor/Wings.hpp"
+#include "../../Source/Compiler/Compiler.hpp"
+#include "../../Source/Compiler/Verifier.hpp"
+#include "../../Source/Virtual/Processor.hpp"
+#include "../../Source/Virtual/Encoding.hpp"
+#include "../../Source/Utility/Serialiser.hpp"
+
+#ifndef SPIN_TRACE
+	#error "Layout needs the tracing processor (-DSPIN_TRACE)!"
+#endif
+
+using namespace Spin;
+
+// Compares the packed Encoding of the Processor with the
+// previous layout, an array of 16 byte ByteCode and its
+// threaded stream of handlers. Every program runs once on
+// the tracing processor and each executed instruction is
+// replayed as the reads of both layouts on two simulated
+// caches (L1 and L2, 8 ways and 64 byte lines). Only the
+// code is simulated, the stack is the same for both.
+
+class Cache {
+	private:
+	static constexpr SizeType line = 64;
+	static constexpr SizeType ways = 8;
+	SizeType sets = 0;
+	UInt64 clock = 0;
+	Array<UInt64> tags;
+	Array<UInt64> used;
+	public:
+	UInt64 misses = 0;
+	Cache(SizeType bytes) {
+		sets = bytes / (line * ways);
+		tags = Array<UInt64>(sets * ways, UINT64_MAX);
+		used = Array<UInt64>(sets * ways, 0);
+	}
+	void read(UInt64 address, SizeType size = 1) {
+		const UInt64 first = address / line;
+		const UInt64 last = (address + size - 1) / line;
+		for (UInt64 block = first; block <= last; block += 1) touch(block);
+	}
+	void touch(UInt64 block) {
+		clock += 1;
+		const SizeType set = (block % sets) * ways;
+		SizeType victim = set;
+		for (SizeType way = set; way < set + ways; way += 1) {
+			if (tags[way] == block) { used[way] = clock; return; }
+			if (used[way] < used[victim]) victim = way;
+		}
+		misses += 1;
+		tags[victim] = block;
+		used[victim] = clock;
+	}
+};
+
+// Distinct regions for every table:
+const UInt64 byteCodes = 0x10000000;
+const UInt64 stream    = 0x20000000;
+const UInt64 packed    = 0x30000000;
+const UInt64 pool      = 0x40000000;
+const UInt64 table     = 0x50000000;
+
+struct Replay {
+	const Encoding * encoding = nullptr;
+	Array<SizeType> addresses;
+	Cache previousL1 = Cache(32 * 1024), previousL2 = Cache(256 * 1024);
+	Cache currentL1 = Cache(32 * 1024), currentL2 = Cache(256 * 1024);
+	UInt64 executed = 0;
+	void read(Cache & l1, Cache & l2, UInt64 address, SizeType size) {
+		const UInt64 misses = l1.misses;
+		l1.read(address, size);
+		if (l1.misses != misses) l2.read(address, size);
+	}
+	void step(SizeType offset) {
+		executed += 1;
+		const SizeType address = addresses[offset];
+		read(previousL1, previousL2, byteCodes + address * sizeof(ByteCode), sizeof(ByteCode));
+		if (Processor::threaded) {
+			read(previousL1, previousL2, stream + address * sizeof(Pointer), sizeof(Pointer));
+		}
+		const UInt8 * data = encoding -> code.data() + offset;
+		read(currentL1, currentL2, packed + offset, Encoding::lengths.of[* data]);
+		if (* data == OPCode::PSH) {
+			read(currentL1, currentL2, pool + Encoding::readIndex(data) * sizeof(Value), sizeof(Value));
+		}
+		if (Processor::threaded) {
+			read(currentL1, currentL2, table + * data * sizeof(Pointer), sizeof(Pointer));
+		}
+	}
+};
+
+Replay replay;
+
+Program * load(String path) {
+	if (path.ends_with(".sexy")) return Program::from(path);
+	SourceCode * code = Wings::spread(path);
+	Program * program = Compiler::self() -> compile(code);
+	delete code;
+	return program;
+}
+
+struct Result {
+	String path;
+	SizeType instructions = 0, executed = 0;
+	SizeType previous = 0, current = 0, constants = 0;
+	UInt64 previousL1 = 0, previousL2 = 0;
+	UInt64 currentL1 = 0, currentL2 = 0;
+};
+
+Int32 main(Int32 argc, Character * argv[]) {
+
+	if (argc < 2) {
+		OStream << endLine << "% Bytecode Layout %" << endLine
+				<< "Usage: Layout <file.spin | file.sexy> ..."
+				<< endLine << endLine;
+		return ExitCodes::failure;
+	}
+
+	Processor * processor = Processor::self();
+	Processor::tracer = [] (SizeType offset) { replay.step(offset); };
+
+	Array<Result> results;
+
+	for (Int32 i = 1; i < argc; i += 1) {
+		Result result = { argv[i] };
+		Program * program = nullptr;
+		try { program = load(result.path); }
+		catch (Program::Error & e) {
+			OStream << endLine << "% " << e.getErrorCode()
+					<< " Error on line " << e.getLine() << " of ['"
+					<< e.getFile() << "'] %" << endLine
+					<< e.getMessage() << endLine << endLine;
+			return ExitCodes::failure;
+		} catch (Manager::BadFileException & b) {
+			OStream << endLine << "% SYS Catastrophic Event %" << endLine
+					<< "Couldn't open or read file ['" << b.getPath()
+					<< "']!" << endLine << endLine;
+			return ExitCodes::failure;
+		} catch (Serialiser::ReadingError & r) {
+			OStream << endLine << "% PPR Catastrophic Event %" << endLine
+					<< "Couldn't read invalid file ['" << result.path
+					<< "']!" << endLine << endLine;
+			return ExitCodes::failure;
+		} catch (Verifier::Error & e) {
+			OStream << endLine << "% VRF Error on address [" << e.getAddress()
+					<< "] %" << endLine << e.getMessage() << endLine << endLine;
+			return ExitCodes::failure;
+		}
+		if (!program) continue;
+		// The Processor encodes the program the same way:
+		const Encoding encoding(program);
+		replay = Replay();
+		replay.encoding = & encoding;
+		replay.addresses = Array<SizeType>(encoding.code.size(), 0);
+		for (SizeType k = 0; k < program -> instructions.size(); k += 1) {
+			replay.addresses[encoding.offsets[k]] = k;
+		}
+		try { processor -> run(program); }
+		catch (Processor::Crash & c) {
+			OStream << endLine << "% EVL Error on address [0x"
+					<< hexadecimal << padding(8) << c.getAddress()
+					<< "] %" << decimal << endLine << endLine;
+			delete program;
+			return ExitCodes::failure;
+		}
+		result.instructions = program -> instructions.size();
+		result.executed = replay.executed;
+		result.previous = result.instructions * sizeof(ByteCode);
+		if (Processor::threaded) result.previous += result.instructions * sizeof(Pointer);
+		result.current = encoding.code.size();
+		result.constants = encoding.constants.size() * sizeof(Value);
+		result.previousL1 = replay.previousL1.misses;
+		result.previousL2 = replay.previousL2.misses;
+		result.currentL1 = replay.currentL1.misses;
+		result.currentL2 = replay.currentL2.misses;
+		results.push_back(result);
+		delete program;
+	}
+
+	OStream << endLine << "% Bytecode Layout %" << endLine;
+	for (auto & result : results) {
+		const SizeType current = result.current + result.constants;
+		OStream << result.path << ": " << result.instructions
+				<< " instructions, " << result.executed << " executed." << endLine
+				<< "    size: " << result.previous << " -> " << current
+				<< " bytes (" << result.current << " code, "
+				<< result.constants << " constants), "
+				<< (100 * current / (result.previous ? result.previous : 1))
+				<< "%." << endLine
+				<< "    L1 misses: " << result.previousL1 << " -> "
+				<< result.currentL1 << ", L2 misses: " << result.previousL2
+				<< " -> " << result.currentL2 << "." << endLine;
+	}
+	OStream << endLine;
+
+	return ExitCodes::success;
+}